@@ -19,33 +19,60 @@ void set_ec_point_pj(EC_POINT_PJ *dest, const EC_POINT_PJ* src)
     dest->is_infty = src->is_infty;
 }
 
-// jaco to affn: (X:Y:Z) --> (X/Z^2, Y/Z^3)
+// affine to field engine domain: (x, y) --> (xR, yR), ecadd_jc의 affine 입력용
+static void af2fe(EC_POINT_AF* point_m, const EC_POINT_AF* point_af)
+{
+    point_m->is_infty = point_af->is_infty;
+    if(point_af->is_infty) return;
+
+    to_fe(&point_m->x, &point_af->x);
+    to_fe(&point_m->y, &point_af->y);
+}
+
+// jaco to affn: (X:Y:Z) --> (X/Z^2, Y/Z^3), field engine domain에서 빠져나옴
 static void jc2af(EC_POINT_AF* point_af, const EC_POINT_PJ* point_pj)
 {
-    BN inv_z2;      // inverse of Z^2
-    BN inv_z3;      // inverse of Z^3
+    BN tmp[2];
 
-    // check infty
-    if(point_pj->is_infty) {
-        point_af->is_infty = 1;
-        return;
+    ec_normalize_batch(point_af, point_pj, 1, tmp);
+}
+
+/*  여러 점을 한번에 jaco to affn: Z 를 모아서 inv_batch 로 역원을 한번만 구한다. (montgomery's trick)
+    tmp 는 호출하는 쪽이 주는 BN 2n 개 (앞 n 개에 Z, 뒤 n 개에 1 / Z). 무한원점은 Z = 1 로 넣고 건너뜀.
+    1-inv + (3(n-1) + 3n)-mul + n-sqr */
+void ec_normalize_batch(EC_POINT_AF* out, const EC_POINT_PJ* in, size_t n, BN* tmp)
+{
+    BN* z = tmp;
+    BN* inv_z = tmp + n;
+    BN inv_z2;      // inverse of Z_i^2, Z_i^3
+
+    if (n == 0) return;
+
+    for (size_t i = 0; i < n; i++) {
+        set_bn(&z[i], in[i].is_infty ? &fe_one : &in[i].z);
     }
-    point_af->is_infty = 0;
+    inv_batch(inv_z, z, n);
 
-    // inverse of Z^2 and Z^3
-    sqrp(&inv_z2, &point_pj->z);
-    mulp(&inv_z3, &inv_z2, &point_pj->z);
-    inv(&inv_z2, &inv_z2);
-    inv(&inv_z3, &inv_z3);
+    for (size_t i = 0; i < n; i++) {
+        // check infty
+        if (in[i].is_infty) {
+            out[i].is_infty = 1;
+            continue;
+        }
 
-    // jaco to affn: x = X/Z^2
-    mulp(&point_af->x, &point_pj->x, &inv_z2);
-    
-    // jaco to affn: y = Y/Z^3
-    mulp(&point_af->y, &point_pj->y, &inv_z3);
+        // (X:Y:Z) --> (X/Z^2, Y/Z^3)
+        sqrp_fe(&inv_z2, &inv_z[i]);
+        mulp_fe(&out[i].x, &in[i].x, &inv_z2);
+        mulp_fe(&inv_z2, &inv_z2, &inv_z[i]);
+        mulp_fe(&out[i].y, &in[i].y, &inv_z2);
+
+        from_fe(&out[i].x, &out[i].x);
+        from_fe(&out[i].y, &out[i].y);
+        out[i].is_infty = 0;
+    }
 }
 
-// affine to jacobian : (x, y) --> (x:y:1)
+// affine to jacobian : (xR, yR) --> (xR:yR:R), point_af는 af2fe를 거친 좌표
 static void af2jc(EC_POINT_PJ* point_pj, const EC_POINT_AF* point_af)
 {
     // check infty
@@ -56,19 +83,16 @@ static void af2jc(EC_POINT_PJ* point_pj, const EC_POINT_AF* point_af)
     point_pj->is_infty = 0;
 
     // affn to jaco : X = x
-    point_pj->x = point_af->x;
+    set_bn(&point_pj->x, &point_af->x);
 
     // affn to jaco : Y = y
-    point_pj->y = point_af->y;
+    set_bn(&point_pj->y, &point_af->y);
 
     // affn to jaco : Z = 1
-    point_pj->z.v[0] = 1;
-    for(int i = 1; i < NUMWORD; i++) {
-        point_pj->z.v[i] = 0;
-    }
+    set_bn(&point_pj->z, &fe_one);
 }
 
-// addtion over affine, 1-inv + 2-mul + 1-sqr + 6-add
+// addtion over affine, 1-inv + 2-mul + 1-sqr + 6-add, 점은 field engine domain (af2fe)
 static void ecadd_af(EC_POINT_AF* point_r, const EC_POINT_AF* point_p, const EC_POINT_AF* point_q) 
 {
     BN lambda, tmp;
@@ -89,17 +113,17 @@ static void ecadd_af(EC_POINT_AF* point_r, const EC_POINT_AF* point_p, const EC_
     // lambda = (Qy - Py) / (Qx - Px)
     subp(&lambda, &point_q->y, &point_p->y);
     subp(&tmp, &point_q->x, &point_p->x);
-    inv(&tmp, &tmp);
-    mulp(&lambda, &lambda, &tmp);
+    inv_fe(&tmp, &tmp);
+    mulp_fe(&lambda, &lambda, &tmp);
 
     // Rx = lambda^2 - Px - Qx
-    sqrp(&rx, &lambda);
+    sqrp_fe(&rx, &lambda);
     subp(&rx, &rx, &point_p->x);
     subp(&rx, &rx, &point_q->x);
  
     // Ry = L * (Rx - Px) - Py
     subp(&ry, &point_p->x, &rx);
-    mulp(&ry, &ry, &lambda);
+    mulp_fe(&ry, &ry, &lambda);
     subp(&ry, &ry, &point_p->y);
 
     // return, *note: ecadd_af(&R, &R, &Q)
@@ -108,7 +132,7 @@ static void ecadd_af(EC_POINT_AF* point_r, const EC_POINT_AF* point_p, const EC_
     point_r->is_infty = 0;
 }
 
-// doubling over affine, 1-inv + 2-mul + 2-sqr + 7-add
+// doubling over affine, 1-inv + 2-mul + 2-sqr + 8-add, 점은 field engine domain (af2fe)
 static void ecdbl_af(EC_POINT_AF* point_r, const EC_POINT_AF* point_p) 
 {
     BN lambda, tmp;
@@ -123,23 +147,23 @@ static void ecdbl_af(EC_POINT_AF* point_r, const EC_POINT_AF* point_p)
     // check inverse available
     if (!ucmp(&point_p->y, &zero)) return;
 
-    // lambda = (3 * Px^2 + a) / 2Py
-    sqrp(&tmp, &point_p->x);
+    // lambda = (3 * Px^2 + a) / 2Py = 3(Px^2 - 1) / 2Py   (a = -3)
+    sqrp_fe(&tmp, &point_p->x);
+    subp(&tmp, &tmp, &fe_one);
     addp(&lambda, &tmp, &tmp);
     addp(&lambda, &lambda, &tmp);
-    addp(&lambda, &lambda, &coef_a);
     addp(&tmp, &point_p->y, &point_p->y);
-    inv(&tmp, &tmp);
-    mulp(&lambda, &lambda, &tmp);
+    inv_fe(&tmp, &tmp);
+    mulp_fe(&lambda, &lambda, &tmp);
 
     // Rx = L^2 - 2Px
-    sqrp(&rx, &lambda);
+    sqrp_fe(&rx, &lambda);
     subp(&rx, &rx, &point_p->x);
     subp(&rx, &rx, &point_p->x);
 
     // Ry = L * (Px - Rx) - Py
     subp(&ry, &point_p->x, &rx);
-    mulp(&ry, &ry, &lambda);
+    mulp_fe(&ry, &ry, &lambda);
     subp(&ry, &ry, &point_p->y);
 
     // return, *note: ecdbl_af(&R, &R, &Q)
@@ -152,59 +176,80 @@ static void ecdbl_af(EC_POINT_AF* point_r, const EC_POINT_AF* point_p)
     아핀에서는 역원을 사용하기 때문에 느리다. 하지만 사영좌표계를 이용하면 역원 연산을 쓰지 않는다.
     아핀좌표계를 사영좌표계로 바꿔준 후 점연산을 진행한다. 연산을 마치면 다시 아핀좌표계로 바꾸어준다.
     ( af2jc --> scalar multiplication --> jc2af )
+
+    자코비안 점연산은 전부 field engine domain 안에서 한다. (mulp_fe, sqrp_fe)
+    기본은 montgomery domain이고, -DECC_FIELD_SOLINAS 이면 변환이 없는 solinas 엔진을 쓴다.
+    domain으로 들어가는 변환은 af2fe, 나오는 변환은 jc2af 에서만 일어난다.
 */
 
-// doubling over jacobian, jacobian = 2*jacobian, 4-mul + 4sqr + 9-add
-static void ecdbl_jc(EC_POINT_PJ* point_r, const EC_POINT_PJ* point_p) 
+/*  doubling over jacobian, a = -3 (dbl-2001-b): (X:Y:Z) 를 제자리에서 2배
+    delta = Z^2, gamma = Y^2, beta = X gamma, alpha = 3(X - delta)(X + delta)
+    X3 = alpha^2 - 8 beta, Y3 = alpha (4 beta - X3) - 8 gamma^2, Z3 = 2YZ
+    3-mul + 3-sqr + 1-(ab - cd) + 10-add, 예전 공식의 반으로 나누기 (Y^4 / 2) 가 없다.
+    sqrp_fe 가 mulp_fe 와 거의 같은 속도라서 Z3 = (Y + Z)^2 - gamma - delta 대신 덧셈이 적은 2YZ 를 쓰고,
+    4 beta = X (4 gamma), 8 gamma^2 = (2 gamma)(4 gamma) 로 덧셈을 줄였다.
+    //note: x86-64 (ADX) 에서는 addp 한번이 mulp_fe 한번과 비슷하게 걸려서 곱셈이 준 만큼 이득이 크지 않다.
+    대신 Y^4 의 홀짝에 따른 분기가 없어졌다. */
+static void ecdbl_jc_core(BN* x, BN* y, BN* z)
 {
-    BN t1, t2, t3;
-    BN rx, ry, rz;
+    BN delta, gamma, beta, alpha, t;
+
+    sqrp_fe(&delta, z);
+    sqrp_fe(&gamma, y);
+    subp(&t, x, &delta);
+    addp(&alpha, x, &delta);
+    mulp_fe(&alpha, &t, &alpha);
+    addp(&t, &alpha, &alpha);
+    addp(&alpha, &alpha, &t);
+
+    // Z3 = 2YZ
+    addp(&t, y, y);
+    mulp_fe(z, &t, z);
+
+    // gamma = 2 gamma, t = 4 gamma, beta = 4 beta
+    addp(&gamma, &gamma, &gamma);
+    addp(&t, &gamma, &gamma);
+    mulp_fe(&beta, x, &t);
+
+    // X3 = alpha^2 - 8 beta
+    addp(&delta, &beta, &beta);
+    sqrp_fe(x, &alpha);
+    subp(x, x, &delta);
+
+    // Y3 = alpha (4 beta - X3) - (4 gamma)(2 gamma), reduction 한번
+    subp(&beta, &beta, x);
+    mulp_sub_mul_fe(y, &alpha, &beta, &t, &gamma);
+}
 
+/*  w 번 연속 doubling: R = 2^w P
+    무한원점 검사와 좌표 복사는 처음 한번만 하고 (R = P 이면 복사 없음), 중간 점은 R 에 제자리로 두고
+    ecdbl_jc_core 를 w 번 부른다. (위수가 소수인 곡선이라 중간에 Y = 0 이 되지 않음)
+    //note: 단계 사이에 값을 넘기는 Itoh 식 반복 doubling 은 쓰지 않았다. 일반 a 에서는 aZ^4 를 넘겨서 sqr 두번을
+    아끼지만, a = -3 에서 넘길 수 있는 건 delta' = Z3^2 = (4 gamma) delta 하나이고 이건 sqr 한번을 mul 한번으로
+    바꿀 뿐이다. (Z3 를 건너뛰어도 마지막에 Z 를 얻으려면 단계마다 Y 를 곱해야 해서 mul 수가 같음)
+    여기서는 sqrp_fe 와 mulp_fe 가 거의 같은 속도라 이득이 없다. */
+static void ecdbl_jc_n(EC_POINT_PJ* point_r, const EC_POINT_PJ* point_p, int w)
+{
     // check infty
     if (point_p->is_infty) {
         point_r->is_infty = 1;
         return;
     }
 
-    // Guide to ECC, p.91
-    sqrp(&t1, &point_p->z);
-    subp(&t2, &point_p->x, &t1);
-    addp(&t1, &point_p->x, &t1);
-    mulp(&t2, &t2, &t1);
-    addp(&t3, &t2, &t2);
-    addp(&t2, &t2, &t3);
-    addp(&ry, &point_p->y, &point_p->y);
-    mulp(&rz, &ry, &point_p->z);
-    sqrp(&ry, &ry);
-    mulp(&t3, &ry, &point_p->x);
-    sqrp(&ry, &ry);
-    
-     // shift, (ry >> 1) < p
-    if(ry.v[0] & 1) { 
-        // if ry is odd
-        uint32_t carry = uadd(&ry, &ry, &P);
-        rshift1(&ry, &ry);
-        ry.v[NUMWORD-1] += (carry << (WORDBITS-1));
-    } else {
-        // if ry is even
-        rshift1(&ry, &ry);
+    if (point_r != point_p) set_ec_point_pj(point_r, point_p);
+    for (int i = 0; i < w; i++) {
+        ecdbl_jc_core(&point_r->x, &point_r->y, &point_r->z);
     }
+}
 
-    sqrp(&rx, &t2);
-    addp(&t1, &t3, &t3);
-    subp(&rx, &rx, &t1);
-    subp(&t1, &t3, &rx);
-    mulp(&t1, &t1, &t2);
-    subp(&ry, &t1, &ry);
-
-    // return, *note: ecdbl_jc(&R, &R)
-    set_bn(&point_r->x, &rx);
-    set_bn(&point_r->y, &ry);
-    set_bn(&point_r->z, &rz);
-    point_r->is_infty = 0;
+// doubling over jacobian, jacobian = 2*jacobian
+static void ecdbl_jc(EC_POINT_PJ* point_r, const EC_POINT_PJ* point_p) 
+{
+    ecdbl_jc_n(point_r, point_p, 1);
 }
 
 // addtion over jacobian, jacobian = jacobian + affine, 8-mul + 3-sqr + 7-add
+// point_q는 field engine domain의 affine 좌표 (af2fe)
 static void ecadd_jc(EC_POINT_PJ* point_r, const EC_POINT_PJ* point_p, const EC_POINT_AF* point_q) 
 {
     BN t1, t2, t3, t4;
@@ -220,10 +265,10 @@ static void ecadd_jc(EC_POINT_PJ* point_r, const EC_POINT_PJ* point_p, const EC_
     }
 
     // Guide to ECC, p.91
-    sqrp(&t1, &point_p->z);
-    mulp(&t2, &t1, &point_p->z);
-    mulp(&t1, &t1, &point_q->x);
-    mulp(&t2, &t2, &point_q->y);
+    sqrp_fe(&t1, &point_p->z);
+    mulp_fe(&t2, &t1, &point_p->z);
+    mulp_fe(&t1, &t1, &point_q->x);
+    mulp_fe(&t2, &t2, &point_q->y);
     subp(&t1, &t1, &point_p->x);
     subp(&t2, &t2, &point_p->y);
 
@@ -246,18 +291,16 @@ static void ecadd_jc(EC_POINT_PJ* point_r, const EC_POINT_PJ* point_p, const EC_
     }
 
     // Guide to ECC, p.92
-    mulp(&rz, &point_p->z, &t1);
-    sqrp(&t3, &t1);
-    mulp(&t4, &t3, &t1);
-    mulp(&t3, &t3, &point_p->x);
+    mulp_fe(&rz, &point_p->z, &t1);
+    sqrp_fe(&t3, &t1);
+    mulp_fe(&t4, &t3, &t1);
+    mulp_fe(&t3, &t3, &point_p->x);
     addp(&t1, &t3, &t3);
-    sqrp(&rx, &t2);
+    sqrp_fe(&rx, &t2);
     subp(&rx, &rx, &t1);
     subp(&rx, &rx, &t4);
     subp(&t3, &t3, &rx);
-    mulp(&t3, &t3, &t2);
-    mulp(&t4, &t4, &point_p->y);
-    subp(&ry, &t3, &t4);
+    mulp_sub_mul_fe(&ry, &t3, &t2, &t4, &point_p->y);     // ry = t3*t2 - t4*Py, reduction 한번
 
     // return, *note: ecadd_jc(&R, &R, &Q)
     set_bn(&point_r->x, &rx);
@@ -266,6 +309,203 @@ static void ecadd_jc(EC_POINT_PJ* point_r, const EC_POINT_PJ* point_p, const EC_
     point_r->is_infty = 0;
 }
 
+/*  addtion over jacobian, jacobian = jacobian + jacobian (add-2007-bl 에서 Z3 = Z1 Z2 H)
+    U1 = X1 Z2^2, U2 = X2 Z1^2, S1 = Y1 Z2^3, S2 = Y2 Z1^3, H = U2 - U1, r = S2 - S1
+    X3 = r^2 - H^3 - 2 U1 H^2, Y3 = r (U1 H^2 - X3) - S1 H^3, Z3 = Z1 Z2 H. 11-mul + 4-sqr + 7-add */
+static void ecadd_jj(EC_POINT_PJ* point_r, const EC_POINT_PJ* point_p, const EC_POINT_PJ* point_q)
+{
+    BN u1, u2, s1, s2, t1, t2;
+    BN rx, ry, rz;
+
+    // check infty
+    if (point_p->is_infty) {
+        set_ec_point_pj(point_r, point_q);
+        return;
+    } else if (point_q->is_infty) {
+        set_ec_point_pj(point_r, point_p);
+        return;
+    }
+
+    sqrp_fe(&t1, &point_q->z);
+    mulp_fe(&u1, &point_p->x, &t1);
+    mulp_fe(&t1, &t1, &point_q->z);
+    mulp_fe(&s1, &point_p->y, &t1);
+    sqrp_fe(&t2, &point_p->z);
+    mulp_fe(&u2, &point_q->x, &t2);
+    mulp_fe(&t2, &t2, &point_p->z);
+    mulp_fe(&s2, &point_q->y, &t2);
+    subp(&u2, &u2, &u1);            // H
+    subp(&s2, &s2, &s1);            // r
+
+    if (!ucmp(&u2, &zero))
+    {
+        if (!ucmp(&s2, &zero)) {
+            // P = Q
+            ecdbl_jc(point_r, point_p);
+        } else {
+            // P = -Q
+            point_r->is_infty = 1;
+        }
+        return;
+    }
+
+    mulp_fe(&rz, &point_p->z, &point_q->z);
+    mulp_fe(&rz, &rz, &u2);
+    sqrp_fe(&t1, &u2);
+    mulp_fe(&t2, &t1, &u2);         // H^3
+    mulp_fe(&u1, &u1, &t1);         // U1 H^2
+    addp(&t1, &u1, &u1);
+    sqrp_fe(&rx, &s2);
+    subp(&rx, &rx, &t2);
+    subp(&rx, &rx, &t1);
+    subp(&u1, &u1, &rx);
+    mulp_sub_mul_fe(&ry, &u1, &s2, &t2, &s1);     // ry = (U1 H^2 - X3) r - H^3 S1, reduction 한번
+
+    set_bn(&point_r->x, &rx);
+    set_bn(&point_r->y, &ry);
+    set_bn(&point_r->z, &rz);
+    point_r->is_infty = 0;
+}
+
+/*  complete addition formulas (Renes-Costello-Batina 2015, a = -3), homogeneous projective
+    무한원점, P = Q, P = -Q 를 포함한 모든 입력에 같은 연산열을 쓰므로 분기가 없다. (소수 위수 곡선에서만 성립)
+    좌표는 전부 field engine domain, b_fe 는 to_fe(coef_b).
+*/
+
+// affine to homogeneous projective : (xR, yR) --> (xR:yR:R), 무한원점 --> (0:R:0)
+static void af2hp(EC_POINT_HP* point_hp, const EC_POINT_AF* point_af)
+{
+    if (point_af->is_infty) {
+        set_bn(&point_hp->x, &zero);
+        set_bn(&point_hp->y, &fe_one);
+        set_bn(&point_hp->z, &zero);
+        return;
+    }
+    set_bn(&point_hp->x, &point_af->x);
+    set_bn(&point_hp->y, &point_af->y);
+    set_bn(&point_hp->z, &fe_one);
+}
+
+// homogeneous projective to affine : (X:Y:Z) --> (X/Z, Y/Z), field engine domain에서 빠져나옴
+static void hp2af(EC_POINT_AF* point_af, const EC_POINT_HP* point_hp)
+{
+    BN inv_z;
+
+    if (!ucmp(&point_hp->z, &zero)) {
+        point_af->is_infty = 1;
+        return;
+    }
+
+    inv_fe(&inv_z, &point_hp->z);
+    mulp_fe(&point_af->x, &point_hp->x, &inv_z);
+    mulp_fe(&point_af->y, &point_hp->y, &inv_z);
+    from_fe(&point_af->x, &point_af->x);
+    from_fe(&point_af->y, &point_af->y);
+    point_af->is_infty = 0;
+}
+
+// complete addition, RCB Algorithm 4, 12-mul + 2-mul(b) + 29-add
+static void ecadd_hp(EC_POINT_HP* point_r, const EC_POINT_HP* point_p, const EC_POINT_HP* point_q, const BN* b_fe)
+{
+    BN t0, t1, t2, t3, t4;
+    BN rx, ry, rz;
+
+    mulp_fe(&t0, &point_p->x, &point_q->x);
+    mulp_fe(&t1, &point_p->y, &point_q->y);
+    mulp_fe(&t2, &point_p->z, &point_q->z);
+    addp(&t3, &point_p->x, &point_p->y);
+    addp(&t4, &point_q->x, &point_q->y);
+    mulp_fe(&t3, &t3, &t4);
+    addp(&t4, &t0, &t1);
+    subp(&t3, &t3, &t4);
+    addp(&t4, &point_p->y, &point_p->z);
+    addp(&rx, &point_q->y, &point_q->z);
+    mulp_fe(&t4, &t4, &rx);
+    addp(&rx, &t1, &t2);
+    subp(&t4, &t4, &rx);
+    addp(&rx, &point_p->x, &point_p->z);
+    addp(&ry, &point_q->x, &point_q->z);
+    mulp_fe(&rx, &rx, &ry);
+    addp(&ry, &t0, &t2);
+    subp(&ry, &rx, &ry);
+    mulp_fe(&rz, b_fe, &t2);
+    subp(&rx, &ry, &rz);
+    addp(&rz, &rx, &rx);
+    addp(&rx, &rx, &rz);
+    subp(&rz, &t1, &rx);
+    addp(&rx, &t1, &rx);
+    mulp_fe(&ry, b_fe, &ry);
+    addp(&t1, &t2, &t2);
+    addp(&t2, &t1, &t2);
+    subp(&ry, &ry, &t2);
+    subp(&ry, &ry, &t0);
+    addp(&t1, &ry, &ry);
+    addp(&ry, &t1, &ry);
+    addp(&t1, &t0, &t0);
+    addp(&t0, &t1, &t0);
+    subp(&t0, &t0, &t2);
+    mulp_fe(&t1, &t4, &ry);
+    mulp_fe(&t2, &t0, &ry);
+    mulp_fe(&ry, &rx, &rz);
+    addp(&ry, &ry, &t2);
+    mulp_fe(&rx, &rx, &t3);
+    subp(&rx, &rx, &t1);
+    mulp_fe(&rz, &rz, &t4);
+    mulp_fe(&t1, &t3, &t0);
+    addp(&rz, &rz, &t1);
+
+    // return, *note: ecadd_hp(&R, &R, &Q)
+    set_bn(&point_r->x, &rx);
+    set_bn(&point_r->y, &ry);
+    set_bn(&point_r->z, &rz);
+}
+
+// doubling, RCB Algorithm 6, 8-mul + 3-sqr + 2-mul(b) + 21-add
+static void ecdbl_hp(EC_POINT_HP* point_r, const EC_POINT_HP* point_p, const BN* b_fe)
+{
+    BN t0, t1, t2, t3;
+    BN rx, ry, rz;
+
+    sqrp_fe(&t0, &point_p->x);
+    sqrp_fe(&t1, &point_p->y);
+    sqrp_fe(&t2, &point_p->z);
+    mulp_fe(&t3, &point_p->x, &point_p->y);
+    addp(&t3, &t3, &t3);
+    mulp_fe(&rz, &point_p->x, &point_p->z);
+    addp(&rz, &rz, &rz);
+    mulp_fe(&ry, b_fe, &t2);
+    subp(&ry, &ry, &rz);
+    addp(&rx, &ry, &ry);
+    addp(&ry, &rx, &ry);
+    subp(&rx, &t1, &ry);
+    addp(&ry, &t1, &ry);
+    mulp_fe(&ry, &rx, &ry);
+    mulp_fe(&rx, &rx, &t3);
+    addp(&t3, &t2, &t2);
+    addp(&t2, &t2, &t3);
+    mulp_fe(&rz, b_fe, &rz);
+    subp(&rz, &rz, &t2);
+    subp(&rz, &rz, &t0);
+    addp(&t3, &rz, &rz);
+    addp(&rz, &rz, &t3);
+    addp(&t3, &t0, &t0);
+    addp(&t0, &t3, &t0);
+    subp(&t0, &t0, &t2);
+    mulp_fe(&t0, &t0, &rz);
+    addp(&ry, &ry, &t0);
+    mulp_fe(&t0, &point_p->y, &point_p->z);
+    addp(&t0, &t0, &t0);
+    mulp_fe(&rz, &t0, &rz);
+    subp(&rx, &rx, &rz);
+    mulp_fe(&rz, &t0, &t1);
+    addp(&rz, &rz, &rz);
+    addp(&rz, &rz, &rz);
+
+    set_bn(&point_r->x, &rx);
+    set_bn(&point_r->y, &ry);
+    set_bn(&point_r->z, &rz);
+}
+
 /*  
     general scalar multiplication: O(2^n)
     LtoR, RtoL and so on: O(n)  
@@ -275,9 +515,11 @@ static void ecadd_jc(EC_POINT_PJ* point_r, const EC_POINT_PJ* point_p, const EC_
 // scalar multiplication of ec, left to right
 void ecsm_ltr(EC_POINT_AF* point_r, const EC_POINT_AF* point_G, const BN* scalar)
 {
+    EC_POINT_AF g_m = {0};
     EC_POINT_PJ ret_pj = {0};
 
     // init
+    af2fe(&g_m, point_G);
     ret_pj.is_infty = 1;
 
     // left to right algorithm
@@ -290,7 +532,7 @@ void ecsm_ltr(EC_POINT_AF* point_r, const EC_POINT_AF* point_G, const BN* scalar
 
             if ((scalar->v[i] >> j) & 1) {
                 // jacobian = jacobian + affine
-                ecadd_jc(&ret_pj, &ret_pj, point_G);
+                ecadd_jc(&ret_pj, &ret_pj, &g_m);
             }
         }
     }
@@ -302,11 +544,11 @@ void ecsm_ltr(EC_POINT_AF* point_r, const EC_POINT_AF* point_G, const BN* scalar
 // scalar multiplication of ec, left to right
 void ecsm_rtl(EC_POINT_AF* point_r, const EC_POINT_AF* point_G, const BN* scalar)
 {
-    EC_POINT_AF g_af = {0};
+    EC_POINT_AF g_m = {0};
     EC_POINT_PJ ret_pj = {0};
 
-    // init
-    set_ec_point_af(&g_af, point_G);
+    // init: G 는 한번만 field engine domain 으로 옮기고 더블링도 그 안에서 한다
+    af2fe(&g_m, point_G);
     ret_pj.is_infty = 1;
 
     // right to left algorithm
@@ -316,11 +558,11 @@ void ecsm_rtl(EC_POINT_AF* point_r, const EC_POINT_AF* point_G, const BN* scalar
         {
             if ((scalar->v[i] >> j) & 1) {
                 // jacobian = jacobian + affine
-                ecadd_jc(&ret_pj, &ret_pj, &g_af);
+                ecadd_jc(&ret_pj, &ret_pj, &g_m);
             }
 
             // affine = affine + affine //! use jacobian only coordinates
-            ecdbl_af(&g_af, &g_af);
+            ecdbl_af(&g_m, &g_m);
         }                  
     }
 
@@ -334,7 +576,24 @@ void ecsm_rtl(EC_POINT_AF* point_r, const EC_POINT_AF* point_G, const BN* scalar
 
     right to left algorithm pre-computed version
     더블링하는 point_G가 고정 값이므로 사전 계산하여 연산 가능.
+
+    fix_g_ltr / fixG_RtoL 은 normal domain 상수이므로, 덧셈마다 af2fe 하지 않도록
+    처음 쓸 때 (또는 ecsm_precomp_init 에서) field engine domain 으로 한번 바꿔둔 표를 쓴다.
 */
+static EC_POINT_AF fix_g_ltr_fe[256];
+static EC_POINT_AF fixG_RtoL_fe[256];
+static int precomp_ready = 0;
+
+void ecsm_precomp_init(void)
+{
+    if (precomp_ready) return;
+
+    for (int i = 0; i < 256; i++) {
+        af2fe(&fix_g_ltr_fe[i], &fix_g_ltr[i]);
+        af2fe(&fixG_RtoL_fe[i], &fixG_RtoL[i]);
+    }
+    precomp_ready = 1;
+}
 
 // left to right algorithm pre-computed version
 void ecsm_ltr_precomp(EC_POINT_AF* point_r, const EC_POINT_AF* point_G, const BN* scalar)
@@ -343,6 +602,7 @@ void ecsm_ltr_precomp(EC_POINT_AF* point_r, const EC_POINT_AF* point_G, const BN
     EC_POINT_PJ ret_pj = {0};
 
     // init
+    if (!precomp_ready) ecsm_precomp_init();
     ret_pj.is_infty = 1;
 
     // left to right algorithm
@@ -350,16 +610,14 @@ void ecsm_ltr_precomp(EC_POINT_AF* point_r, const EC_POINT_AF* point_G, const BN
     {
         for (int k = 3; k >= 0; k--) 
         {
-            for (int j = 0; j < 8; j++){
-                // doubling
-                ecdbl_jc(&ret_pj, &ret_pj);
-            }
+            // doubling 8번
+            ecdbl_jc_n(&ret_pj, &ret_pj, 8);
 
             // scanning 8-bits
             offset = (scalar->v[i] >> (k * 8)) & 0xFF;
 
             // addition
-            ecadd_jc(&ret_pj, &ret_pj, &fix_g_ltr[offset]);
+            ecadd_jc(&ret_pj, &ret_pj, &fix_g_ltr_fe[offset]);
         }
     }
 
@@ -373,6 +631,7 @@ void ecsm_rtl_precomp(EC_POINT_AF* point_r, const EC_POINT_AF* point_G, const BN
     EC_POINT_PJ ret_pj = {0};
 
     // init
+    if (!precomp_ready) ecsm_precomp_init();
     ret_pj.is_infty = 1;
 
     // right to left algorithm
@@ -382,7 +641,7 @@ void ecsm_rtl_precomp(EC_POINT_AF* point_r, const EC_POINT_AF* point_G, const BN
         {
             if ((scalar->v[i] >> j) & 1) {
                 // addition
-                ecadd_jc(&ret_pj, &ret_pj, &fixG_RtoL[i*32+j]);
+                ecadd_jc(&ret_pj, &ret_pj, &fixG_RtoL_fe[i*32+j]);
             }
         }
     }
@@ -392,44 +651,911 @@ void ecsm_rtl_precomp(EC_POINT_AF* point_r, const EC_POINT_AF* point_G, const BN
 }
 
 
+/*  fixed base comb (Lim-Lee)
+    스칼라 비트 k_0 .. k_255 를 ECC_COMB_TEETH 행 x ECC_COMB_COLS 열로 놓는다. (행 i 는 비트 i * COLS ..)
+    같은 열의 비트들을 모은 TEETH 비트 인덱스 j 에 대해 표에 sum_{j 의 비트 i} 2^{i COLS} G 를 저장하면
+    열 하나를 덧셈 한번으로 처리할 수 있고, 더블링은 열 수만큼만 한다.
+    열을 ECC_COMB_BLOCKS 개로 더 나누면 블록마다 2^{b SPAN} 배 된 표를 따로 두고, 더블링이 SPAN 번으로 준다.
+
+    표는 빌드 설정에 맞춰 처음 쓸 때 (또는 ecsm_comb_init 에서) G 로부터 만든다. field engine domain 의 affine 좌표.
+    인덱스 0 은 무한원점이라 덧셈을 건너뛴다. (ecsm_ltr_precomp 처럼 상수 시간은 아님)
+    여러 스레드에서 쓰려면 ecsm_comb_init 을 먼저 한번 부른다. */
+static EC_POINT_AF comb_tbl[ECC_COMB_BLOCKS][1 << ECC_COMB_TEETH];
+static int comb_ready = 0;
+
+void ecsm_comb_init(void)
+{
+    EC_POINT_PJ tbl_pj[1 << ECC_COMB_TEETH];
+    EC_POINT_AF base[ECC_COMB_TEETH];
+    BN tmp[2 << ECC_COMB_TEETH];        // ec_normalize_batch
+    EC_POINT_PJ blk_pj = {0}, t_pj = {0};
+    int top = 0;
+
+    if (comb_ready) return;
+
+    // blk_pj = G
+    af2fe(&base[0], &fix_g_ltr[1]);
+    af2jc(&blk_pj, &base[0]);
+
+    for (int b = 0; b < ECC_COMB_BLOCKS; b++) {
+        // base[i] = 2^{i COLS} 2^{b SPAN} G
+        set_ec_point_pj(&t_pj, &blk_pj);
+        for (int i = 0; i < ECC_COMB_TEETH; i++) {
+            jc2af(&base[i], &t_pj);
+            af2fe(&base[i], &base[i]);
+            if (i + 1 < ECC_COMB_TEETH) ecdbl_jc_n(&t_pj, &t_pj, ECC_COMB_COLS);
+        }
+        ecdbl_jc_n(&blk_pj, &blk_pj, ECC_COMB_SPAN);
+
+        // tbl_pj[j] = tbl_pj[j - 2^top] + base[top], top 은 j 의 최상위 비트
+        tbl_pj[0].is_infty = 1;
+        top = 0;
+        for (int j = 1; j < (1 << ECC_COMB_TEETH); j++) {
+            if (j == (2 << top)) top++;
+            ecadd_jc(&tbl_pj[j], &tbl_pj[j ^ (1 << top)], &base[top]);
+        }
+
+        ec_normalize_batch(comb_tbl[b], tbl_pj, 1 << ECC_COMB_TEETH, tmp);
+        for (int j = 1; j < (1 << ECC_COMB_TEETH); j++) af2fe(&comb_tbl[b][j], &comb_tbl[b][j]);
+    }
+
+    comb_ready = 1;
+}
+
+// 스칼라의 pos 번째 비트 (256 이상은 0)
+static uint32_t comb_bit(const BN* scalar, int pos)
+{
+    if (pos >= BITS256) return 0;
+    return (scalar->v[pos / WORDBITS] >> (pos % WORDBITS)) & 1;
+}
+
+// fixed base comb, point_G 는 쓰지 않는다 (G 고정, ecsm_ltr_precomp 와 같은 인터페이스)
+void ecsm_comb(EC_POINT_AF* point_r, const EC_POINT_AF* point_G, const BN* scalar)
+{
+    EC_POINT_PJ ret_pj = {0};
+    uint32_t idx = 0;
+    int col = 0;
+
+    (void)point_G;
+    if (!comb_ready) ecsm_comb_init();
+
+    ret_pj.is_infty = 1;
+    for (int j = ECC_COMB_SPAN - 1; j >= 0; j--)
+    {
+        ecdbl_jc(&ret_pj, &ret_pj);
+
+        for (int b = 0; b < ECC_COMB_BLOCKS; b++)
+        {
+            // 블록 b 의 j 번째 열: 비트 i * COLS + b * SPAN + j
+            col = b * ECC_COMB_SPAN + j;
+            if (col >= ECC_COMB_COLS) continue;
+
+            idx = 0;
+            for (int i = 0; i < ECC_COMB_TEETH; i++) {
+                idx |= comb_bit(scalar, i * ECC_COMB_COLS + col) << i;
+            }
+            if (idx) ecadd_jc(&ret_pj, &ret_pj, &comb_tbl[b][idx]);
+        }
+    }
+
+    jc2af(point_r, &ret_pj);
+}
+
+/*  constant time fixed window (regular signed digit)
+    k 가 홀수이면 k = sum d_i 2^{w i}, d_i 는 홀수이고 |d_i| < 2^w 로 쓸 수 있다. (0 인 자리가 없음)
+        d_i = (k mod 2^{w+1}) - 2^w,  k <-- (k >> w) | 1,  마지막 자리는 남은 k (양수)
+    짝수이면 k + n 을 쓴다. (nG = O) 그래서 스칼라는 257비트, 자리는 257 / w + 1 개로 고정.
+    매 자리마다 더블링 w 번과 덧셈 한번. 표 T[j] = (2j + 1) G 에서 |d_i| >> 1 번째를 읽고 d_i < 0 이면 y 부호를 바꾼다.
+
+    표를 읽을 때는 모든 항목을 읽고 인덱스가 같은 것만 마스크로 남긴다. (캐시 타이밍 방지)
+    x86-64 에서는 SSE2 (항목당 128비트 4번) 또는 AVX2 (256비트 2번, 실행 중 확인) 로 읽는다. -DECC_NO_ASM 이면 C 코드.
+    ecadd_jc 의 예외 처리 분기 (acc = +-T) 는 acc 와 T 가 같은 점일 때만 타므로 무작위 스칼라에서는 일어나지 않는다.
+    표는 ecsm_comb 처럼 처음 쓸 때 (또는 ecsm_ct_init 에서) 만든다. */
+#define CT_TBL      (1 << (ECC_CT_W - 1))
+#define CT_DIGITS   ((BITS256 + 1) / ECC_CT_W + 1)
+
+typedef struct {
+    uint32_t xy[2 * NUMWORD];       // field engine domain 의 x || y
+} CT_ENTRY;
+
+static CT_ENTRY ct_tbl[CT_TBL];
+static int ct_ready = 0;
+
+void ecsm_ct_init(void)
+{
+    EC_POINT_PJ tbl_pj[CT_TBL];
+    EC_POINT_AF tbl_af[CT_TBL];
+    BN tmp[2 * CT_TBL];                 // ec_normalize_batch
+    EC_POINT_AF g_m = {0}, d_m = {0};
+    EC_POINT_PJ d_pj = {0};
+
+    if (ct_ready) return;
+
+    // T[j] = T[j - 1] + 2G
+    af2fe(&g_m, &fix_g_ltr[1]);
+    af2jc(&tbl_pj[0], &g_m);
+    ecdbl_jc(&d_pj, &tbl_pj[0]);
+    jc2af(&d_m, &d_pj);
+    af2fe(&d_m, &d_m);
+    for (int j = 1; j < CT_TBL; j++) ecadd_jc(&tbl_pj[j], &tbl_pj[j - 1], &d_m);
+
+    ec_normalize_batch(tbl_af, tbl_pj, CT_TBL, tmp);
+    for (int j = 0; j < CT_TBL; j++) {
+        af2fe(&tbl_af[j], &tbl_af[j]);
+        memcpy(&ct_tbl[j].xy[0], tbl_af[j].x.v, sizeof(tbl_af[j].x.v));
+        memcpy(&ct_tbl[j].xy[NUMWORD], tbl_af[j].y.v, sizeof(tbl_af[j].y.v));
+    }
+
+    ct_ready = 1;
+}
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(ECC_NO_ASM)
+#define ECC_CT_SIMD
+#include <immintrin.h>
+
+static void ct_lookup_sse2(uint32_t* out, uint32_t idx)
+{
+    const __m128i iv = _mm_set1_epi32((int)idx);
+    __m128i r[4], m;
+
+    for (int k = 0; k < 4; k++) r[k] = _mm_setzero_si128();
+    for (int j = 0; j < CT_TBL; j++) {
+        m = _mm_cmpeq_epi32(_mm_set1_epi32(j), iv);
+        for (int k = 0; k < 4; k++) {
+            r[k] = _mm_or_si128(r[k], _mm_and_si128(m, _mm_loadu_si128((const __m128i*)ct_tbl[j].xy + k)));
+        }
+    }
+    for (int k = 0; k < 4; k++) _mm_storeu_si128((__m128i*)out + k, r[k]);
+}
+
+__attribute__((target("avx2"))) static void ct_lookup_avx2(uint32_t* out, uint32_t idx)
+{
+    const __m256i iv = _mm256_set1_epi32((int)idx);
+    __m256i r0 = _mm256_setzero_si256(), r1 = _mm256_setzero_si256(), m;
+
+    for (int j = 0; j < CT_TBL; j++) {
+        m = _mm256_cmpeq_epi32(_mm256_set1_epi32(j), iv);
+        r0 = _mm256_or_si256(r0, _mm256_and_si256(m, _mm256_loadu_si256((const __m256i*)ct_tbl[j].xy)));
+        r1 = _mm256_or_si256(r1, _mm256_and_si256(m, _mm256_loadu_si256((const __m256i*)ct_tbl[j].xy + 1)));
+    }
+    _mm256_storeu_si256((__m256i*)out, r0);
+    _mm256_storeu_si256((__m256i*)out + 1, r1);
+}
+#endif
+
+// out = ct_tbl[idx], 표 전체를 읽는다
+static void ct_lookup(uint32_t* out, uint32_t idx)
+{
+#ifdef ECC_CT_SIMD
+    static int avx2 = -1;
+
+    if (avx2 < 0) avx2 = __builtin_cpu_supports("avx2") ? 1 : 0;
+    if (avx2) ct_lookup_avx2(out, idx);
+    else ct_lookup_sse2(out, idx);
+#else
+    uint32_t m = 0;
+
+    for (int k = 0; k < 2 * NUMWORD; k++) out[k] = 0;
+    for (uint32_t j = 0; j < CT_TBL; j++) {
+        m = 0 - (uint32_t)(((uint64_t)(j ^ idx) - 1) >> 63);    // j == idx 이면 0xffffffff
+        for (int k = 0; k < 2 * NUMWORD; k++) out[k] |= ct_tbl[j].xy[k] & m;
+    }
+#endif
+}
+
+// 257비트 k 의 pos 번째 비트부터 w + 1 비트 (위치는 공개값)
+static uint32_t ct_bits(const uint32_t* k, int pos, int w)
+{
+    uint64_t t = k[pos / WORDBITS];
+
+    if (pos / WORDBITS + 1 <= NUMWORD) t |= (uint64_t)k[pos / WORDBITS + 1] << WORDBITS;
+    return (uint32_t)(t >> (pos % WORDBITS)) & ((1u << (w + 1)) - 1);
+}
+
+// q = (sign ? -T[idx] : T[idx]), sign 은 0 또는 0xffffffff
+static void ct_select(EC_POINT_AF* q, uint32_t idx, uint32_t sign)
+{
+    uint32_t xy[2 * NUMWORD];
+    BN ny;
+
+    ct_lookup(xy, idx);
+    memcpy(q->x.v, &xy[0], sizeof(q->x.v));
+    memcpy(q->y.v, &xy[NUMWORD], sizeof(q->y.v));
+    q->is_infty = 0;
+
+    subp(&ny, &zero, &q->y);
+    cset_bn(&q->y, &ny, sign);
+}
+
+// constant time fixed base, point_G 는 쓰지 않는다 (G 고정, ecsm_ltr_precomp 와 같은 인터페이스)
+void ecsm_ct(EC_POINT_AF* point_r, const EC_POINT_AF* point_G, const BN* scalar)
+{
+    uint32_t k[NUMWORD + 1], kn[NUMWORD + 1];
+    uint32_t even = 0, d = 0, sign = 0;
+    uint64_t c = 0;
+    EC_POINT_AF q = {0};
+    EC_POINT_PJ ret_pj = {0};
+
+    (void)point_G;
+    if (!ct_ready) ecsm_ct_init();
+
+    // 짝수이면 k + n
+    for (int i = 0; i < NUMWORD; i++) {
+        c += (uint64_t)scalar->v[i] + N.v[i];
+        kn[i] = (uint32_t)c;
+        c >>= 32;
+        k[i] = scalar->v[i];
+    }
+    kn[NUMWORD] = (uint32_t)c;
+    k[NUMWORD] = 0;
+    even = (scalar->v[0] & 1) - 1;
+    for (int i = 0; i <= NUMWORD; i++) k[i] ^= (k[i] ^ kn[i]) & even;
+
+    // 최상위 자리: 남은 k (양수, 홀수)
+    d = (ct_bits(k, (CT_DIGITS - 1) * ECC_CT_W, ECC_CT_W) | 1);
+    ct_select(&q, d >> 1, 0);
+    af2jc(&ret_pj, &q);
+
+    for (int i = CT_DIGITS - 2; i >= 0; i--)
+    {
+        ecdbl_jc_n(&ret_pj, &ret_pj, ECC_CT_W);
+
+        // d = (w + 1 비트, 최하위 비트는 1) - 2^w, |d| 와 부호를 분기 없이
+        d = (ct_bits(k, i * ECC_CT_W, ECC_CT_W) | 1) - (1u << ECC_CT_W);
+        sign = 0 - (d >> 31);
+        d = (d ^ sign) - sign;
+
+        ct_select(&q, d >> 1, sign);
+        ecadd_jc(&ret_pj, &ret_pj, &q);
+    }
+
+    jc2af(point_r, &ret_pj);
+}
+
+/*  complete formula 를 쓰는 left to right: 매 비트마다 더블링과 덧셈을 모두 하고 결과를 마스크로 고른다.
+    스칼라 비트에 따른 분기와 무한원점/같은 점 검사가 없다. (point_G 가 무한원점이어도 같은 경로) */
+void ecsm_complete(EC_POINT_AF* point_r, const EC_POINT_AF* point_G, const BN* scalar)
+{
+    BN b_fe;
+    uint32_t mask = 0;
+    EC_POINT_AF g_m = {0};
+    EC_POINT_AF infty = {0};
+    EC_POINT_HP g_hp, ret_hp, sum_hp;
+
+    // init: ret = (0:1:0)
+    to_fe(&b_fe, &coef_b);
+    af2fe(&g_m, point_G);
+    af2hp(&g_hp, &g_m);
+    infty.is_infty = 1;
+    af2hp(&ret_hp, &infty);
+
+    for(int i = NUMWORD - 1; i >= 0; i--) 
+    {
+        for (int j = WORDBITS - 1; j >= 0; j--) 
+        {
+            ecdbl_hp(&ret_hp, &ret_hp, &b_fe);
+            ecadd_hp(&sum_hp, &ret_hp, &g_hp, &b_fe);
+
+            // bit = 1 이면 ret = ret + G
+            mask = 0 - ((scalar->v[i] >> j) & 1);
+            cset_bn(&ret_hp.x, &sum_hp.x, mask);
+            cset_bn(&ret_hp.y, &sum_hp.y, mask);
+            cset_bn(&ret_hp.z, &sum_hp.z, mask);
+        }
+    }
+
+    hp2af(point_r, &ret_hp);
+}
+
+
+
+
+
+/*  LtoR, RtoL은 non-constant --> 몽고메리 래더 알고리즘을 사용. 
+    몽고메리 래더는 매 비트마다 덧셈 한번 + 더블링 한번을 같은 순서로 하므로 스칼라 비트에 따른 분기가 없다.
+    mix 좌표계 (jacobian + affine) 는 래더에 맞지 않으므로 Co-Z (Z를 공유하는 jacobian) 덧셈 공식을 쓴다.
+    (Goundar, Joye, Miyaji, Rivain, Venelli, "Scalar multiplication on Weierstrass elliptic curves from Co-Z arithmetic", 2011)
+
+    두 점 R0 = mP, R1 = (m+1)P 는 항상 같은 Z 를 가지며 Z 는 저장하지 않는다. (X, Y) 만 가지고 계산하고
+    마지막에 R1 - R0 = P 를 이용해 Z 를 복원한다. 비트당 9-mul + 5-sqr (ecadd_xycz_c + ecadd_xycz).
+*/
+
+// Co-Z addition (XYCZ-ADD): (P, Q) --> (P', P + Q), P' 는 P 와 같은 점이고 Z 만 P + Q 와 같아짐, 4-mul + 2-sqr + 7-add
+static void ecadd_xycz(BN* x1, BN* y1, BN* x2, BN* y2)
+{
+    BN c, w1, w2, d;
+
+    subp(&c, x1, x2);
+    sqrp_fe(&c, &c);
+    mulp_fe(&w1, x1, &c);
+    mulp_fe(&w2, x2, &c);
+    subp(&d, y1, y2);
+    subp(&c, &w1, &w2);
+    mulp_fe(y1, y1, &c);            // P'y = Y1 (W1 - W2)
+    set_bn(x1, &w1);                // P'x = W1
+
+    // X3 = D^2 - W1 - W2, Y3 = D (W1 - X3) - P'y
+    sqrp_fe(x2, &d);
+    subp(x2, x2, &w1);
+    subp(x2, x2, &w2);
+    subp(&c, &w1, x2);
+    mulp_fe(&c, &d, &c);
+    subp(y2, &c, y1);
+}
+
+// conjugate Co-Z addition (XYCZ-ADDC): (P, Q) --> (P - Q, P + Q), 5-mul + 3-sqr + 10-add
+static void ecadd_xycz_c(BN* x1, BN* y1, BN* x2, BN* y2)
+{
+    BN c, w1, w2, a1, d, t;
+
+    subp(&c, x1, x2);
+    sqrp_fe(&c, &c);
+    mulp_fe(&w1, x1, &c);
+    mulp_fe(&w2, x2, &c);
+    subp(&c, &w1, &w2);
+    mulp_fe(&a1, y1, &c);
+    addp(&t, &w1, &w2);
+
+    // P + Q: D = Y1 - Y2, P - Q: D = Y1 + Y2
+    subp(&d, y1, y2);
+    addp(y1, y1, y2);
+
+    sqrp_fe(x2, &d);
+    subp(x2, x2, &t);
+    subp(&c, &w1, x2);
+    mulp_fe(&c, &d, &c);
+    subp(y2, &c, &a1);
+
+    sqrp_fe(x1, y1);
+    subp(x1, x1, &t);
+    subp(&c, &w1, x1);
+    mulp_fe(&c, y1, &c);
+    subp(y1, &c, &a1);
+}
+
+/*  Co-Z initial doubling (XYCZ-IDBL), a = -3: affine P = (px, py) (field engine domain) 에서
+    2P 와 P 를 같은 Z = 2py 로 만든다. P 는 (4px py^2, 8py^4), 2P 는 M = 3(px - 1)(px + 1) 로
+    (M^2 - 2S, M(S - X) - 8py^4), S = 4px py^2. 3-mul + 3-sqr + 9-add */
+static void ecdbl_xycz(BN* x2, BN* y2, BN* x1, BN* y1, const BN* px, const BN* py)
+{
+    BN t, u, m;
+
+    subp(&t, px, &fe_one);
+    addp(&m, px, &fe_one);
+    mulp_fe(&m, &t, &m);
+    addp(&t, &m, &m);
+    addp(&m, &m, &t);                   // M = 3(x - 1)(x + 1)
+    sqrp_fe(&t, py);
+    addp(&t, &t, &t);                   // 2y^2
+    addp(&u, &t, &t);
+    mulp_fe(x1, px, &u);                // S = 4xy^2
+    sqrp_fe(&t, &t);
+    addp(y1, &t, &t);                   // 8y^4
+    sqrp_fe(x2, &m);
+    addp(&t, x1, x1);
+    subp(x2, x2, &t);                   // M^2 - 2S
+    subp(&t, x1, x2);
+    mulp_fe(&t, &m, &t);
+    subp(y2, &t, y1);                   // M(S - X) - 8y^4
+}
+
+/*  scalar multiplication of ec, Co-Z montgomery ladder (regular, constant-time)
+    스칼라를 k' = k + 2n 또는 k + 3n 으로 바꿔서 항상 258비트, 최상위 비트 1 로 만든다. (k' P = k P)
+    이렇게 하면 래더 중간에 무한원점이나 R0 = +-R1 이 되는 경우는 k = 0, n - 1 뿐이고, 이 둘은 마지막에 마스크로 고친다.
+    마지막 Z 복원은 x_P 로 나누므로 x_P = 0 인 점 (0, +-sqrt(b)) 에는 쓸 수 없다. 이때는 P' = 2P (x 는 0 이 아님),
+    k' = k / 2 mod n 으로 바꿔서 계산한다. (k' P' = k P)
+    point_G 가 무한원점인지, x 가 0 인지는 기준점 (공개값) 에만 의존하므로 처음에 한번 분기한다. */
+void ecsm_ladder(EC_POINT_AF* point_r, const EC_POINT_AF* point_G, const BN* scalar)
+{
+    BN k, nm1;
+    BN x[2], y[2];                      // R0, R1 (co-Z)
+    BN px, py, t, u;
+    EC_POINT_AF g2 = {0};
+    const EC_POINT_AF* base = point_G;
+    uint32_t kp[NUMWORD + 1], kp3[NUMWORD + 1];
+    uint32_t mask = 0, bit = 0, prev = 0, is_zero = 0, is_nm1 = 0, carry = 0;
+    uint64_t c2 = 0, c3 = 0;
+
+    if (point_G->is_infty) {
+        point_r->is_infty = 1;
+        return;
+    }
+
+    // k = scalar mod n
+    mask = 0 - usub(&k, scalar, &N);
+    cset_bn(&k, scalar, mask);
+    usub(&nm1, &N, &one);
+
+    // x_P = 0: P' = 2P, k' = k / 2 = (k 가 홀수이면 k + n) >> 1 (mod n)
+    if (!ucmp(&point_G->x, &zero)) {
+        af2fe(&g2, point_G);
+        ecdbl_af(&g2, &g2);
+        from_fe(&g2.x, &g2.x);
+        from_fe(&g2.y, &g2.y);
+        base = &g2;
+
+        mask = 0 - (k.v[0] & 1);
+        for (int i = 0; i < NUMWORD; i++) t.v[i] = N.v[i] & mask;
+        carry = uadd(&k, &k, &t);
+        rshift1(&k, &k);
+        k.v[NUMWORD - 1] |= carry << (WORDBITS - 1);
+    }
+    is_zero = 0 - (uint32_t)(ucmp(&k, &zero) == 0);
+    is_nm1 = 0 - (uint32_t)(ucmp(&k, &nm1) == 0);
+
+    // k' = k + 2n (2^257 이상이면) 또는 k + 3n
+    for (int i = 0; i < NUMWORD; i++) {
+        c2 += (uint64_t)k.v[i] + 2 * (uint64_t)N.v[i];
+        c3 += (uint64_t)k.v[i] + 3 * (uint64_t)N.v[i];
+        kp[i] = (uint32_t)c2;
+        kp3[i] = (uint32_t)c3;
+        c2 >>= 32;
+        c3 >>= 32;
+    }
+    kp[NUMWORD] = (uint32_t)c2;
+    kp3[NUMWORD] = (uint32_t)c3;
+    mask = ((kp[NUMWORD] >> 1) & 1) - 1;
+    for (int i = 0; i <= NUMWORD; i++) {
+        kp[i] ^= (kp[i] ^ kp3[i]) & mask;
+    }
+
+    // init: R1 = 2P, R0 = P (Z = 2y 로 같음)
+    to_fe(&px, &base->x);
+    to_fe(&py, &base->y);
+    ecdbl_xycz(&x[1], &y[1], &x[0], &y[0], &px, &py);
+
+    /*  비트 b 에 대해 (R_{1-b}, R_b) <-- (R_b + R_{1-b}, R_b - R_{1-b}), (R_b, R_{1-b}) <-- (R_{1-b} + R_b, R_{1-b}')
+        R_b 가 슬롯 0 에 오도록 바꿔서 (cswap) 계산하고, 연속된 바꿈은 b ^ prev 로 합친다. */
+    for (int i = BITS256; i >= 0; i--) {
+        bit = (kp[i / WORDBITS] >> (i % WORDBITS)) & 1;
+        mask = 0 - (bit ^ prev);
+        cswap_bn(&x[0], &x[1], mask);
+        cswap_bn(&y[0], &y[1], mask);
+        prev = bit;
+
+        ecadd_xycz_c(&x[0], &y[0], &x[1], &y[1]);
+        if (i == 0) break;
+        ecadd_xycz(&x[1], &y[1], &x[0], &y[0]);
+    }
+
+    /*  마지막 비트: 슬롯 0 은 R_b - R_{1-b} = (-1)^{1-b} P 를 현재 Z 로 나타낸 것이므로
+        Z = +-x_P Y_0 / (y_P X_0), 마지막 덧셈 후의 Z 는 여기에 (X_1 - X_0) 을 곱한 값.
+        lambda = 1 / Z = y_P X_0 / (x_P Y_0 (X_1 - X_0)), b = 0 이면 부호 반대
+        k = 0, n - 1 이면 분모가 0 이 될 수 있다. 이 결과는 마지막에 버리므로 1 로 바꿔서
+        inv_fe 에 0 이 들어가지 않게 한다. (EEA 역원은 0 에서 끝나지 않음) */
+    subp(&t, &x[1], &x[0]);
+    mulp_fe(&t, &t, &y[0]);
+    mulp_fe(&t, &t, &px);
+    cset_bn(&t, &fe_one, is_zero | is_nm1);
+    inv_fe(&t, &t);
+    mulp_fe(&t, &t, &py);
+    mulp_fe(&t, &t, &x[0]);
+    subp(&u, &zero, &t);
+    cset_bn(&t, &u, bit - 1);
+
+    ecadd_xycz(&x[1], &y[1], &x[0], &y[0]);
+    cswap_bn(&x[0], &x[1], 0 - bit);
+    cswap_bn(&y[0], &y[1], 0 - bit);
+
+    // (X0 lambda^2, Y0 lambda^3)
+    sqrp_fe(&u, &t);
+    mulp_fe(&point_r->x, &x[0], &u);
+    mulp_fe(&u, &u, &t);
+    mulp_fe(&point_r->y, &y[0], &u);
+    from_fe(&point_r->x, &point_r->x);
+    from_fe(&point_r->y, &point_r->y);
+
+    // k = n - 1 --> -P, k = 0 --> 무한원점
+    subp(&u, &zero, &base->y);
+    cset_bn(&point_r->x, &base->x, is_nm1);
+    cset_bn(&point_r->y, &u, is_nm1);
+    point_r->is_infty = is_zero & 1;
+}
+
+/*  width-w NAF: 0 이 아닌 자리는 홀수이고 |d| < 2^{w-1}, 0 이 아닌 자리 사이에는 0 이 w-1 개 이상.
+    naf[0] 이 최하위 자리, 길이 리턴 (최대 BITS256 + 1) */
+static int wnaf_recode(int8_t* naf, const BN* scalar, int w)
+{
+    uint32_t k[NUMWORD + 1], nz = 0;
+    uint64_t c = 0;
+    int len = 0, d = 0;
+
+    for (int i = 0; i < NUMWORD; i++) k[i] = scalar->v[i];
+    k[NUMWORD] = 0;
+
+    for (;;) {
+        nz = 0;
+        for (int i = 0; i <= NUMWORD; i++) nz |= k[i];
+        if (nz == 0) break;
+
+        d = 0;
+        if (k[0] & 1) {
+            // d = k mods 2^w, k = k - d
+            d = (int)(k[0] & ((1u << w) - 1));
+            if (d >= (1 << (w - 1))) d -= (1 << w);
+
+            if (d > 0) {
+                c = (uint64_t)k[0] - (uint32_t)d;
+                k[0] = (uint32_t)c;
+                for (int i = 1; i <= NUMWORD && (c >> 63); i++) {
+                    c = (uint64_t)k[i] - 1;
+                    k[i] = (uint32_t)c;
+                }
+            } else {
+                c = (uint64_t)k[0] + (uint32_t)(-d);
+                k[0] = (uint32_t)c;
+                for (int i = 1; i <= NUMWORD && (c >> 32); i++) {
+                    c = (uint64_t)k[i] + 1;
+                    k[i] = (uint32_t)c;
+                }
+            }
+        }
+        naf[len++] = (int8_t)d;
+
+        for (int i = 0; i < NUMWORD; i++) {
+            k[i] = (k[i] >> 1) | (k[i + 1] << (WORDBITS - 1));
+        }
+        k[NUMWORD] >>= 1;
+    }
+
+    return len;
+}
+
+#if ECC_DSM_WG > ECC_WNAF_WMAX
+#define WNAF_TBL_MAX    (1 << (ECC_DSM_WG - 2))
+#else
+#define WNAF_TBL_MAX    (1 << (ECC_WNAF_WMAX - 2))
+#endif
+
+/*  tbl[i] = (2i + 1)P, i < cnt (field engine domain 의 affine, P 는 무한원점이 아님)
+    XYCZ-IDBL 로 2P 와 P 를 같은 Z 로 두고 ecadd_xycz(2P, (2i-1)P) 를 반복하면 (2i+1)P 가 나오고
+    Z 는 매번 (X_2P - X_{2i-1}) 배가 된다. 이 비율을 저장해 두었다가 마지막 Z 의 역원 하나로 모든 점을 affine 으로 만든다. */
+static void wnaf_table(EC_POINT_AF* tbl, const EC_POINT_AF* point_p, int cnt)
+{
+    BN f[WNAF_TBL_MAX];                 // f[i] = Z_i / Z_{i-1}
+    BN px, py, dx, dy, iz, iz2;
+
+    // tbl[i] = (2i + 1)P, Z_i = Z_{i-1} f[i], Z_0 = 2y
+    to_fe(&px, &point_p->x);
+    to_fe(&py, &point_p->y);
+    ecdbl_xycz(&dx, &dy, &tbl[0].x, &tbl[0].y, &px, &py);
+    addp(&f[0], &py, &py);
+    for (int i = 1; i < cnt; i++) {
+        subp(&f[i], &dx, &tbl[i - 1].x);
+        set_bn(&tbl[i].x, &tbl[i - 1].x);
+        set_bn(&tbl[i].y, &tbl[i - 1].y);
+        ecadd_xycz(&dx, &dy, &tbl[i].x, &tbl[i].y);
+    }
+
+    // 1 / Z_{cnt-1} 에서 시작해서 1 / Z_{i-1} = (1 / Z_i) f[i]
+    set_bn(&iz, &f[0]);
+    for (int i = 1; i < cnt; i++) mulp_fe(&iz, &iz, &f[i]);
+    inv_fe(&iz, &iz);
+    for (int i = cnt - 1; i >= 0; i--) {
+        sqrp_fe(&iz2, &iz);
+        mulp_fe(&tbl[i].x, &tbl[i].x, &iz2);
+        mulp_fe(&iz2, &iz2, &iz);
+        mulp_fe(&tbl[i].y, &tbl[i].y, &iz2);
+        tbl[i].is_infty = 0;
+        if (i > 0) mulp_fe(&iz, &iz, &f[i]);
+    }
+}
+
+// ret = ret + d P, d 는 0 이 아닌 홀수, tbl 은 wnaf_table 의 홀수배 표. 음수는 y 부호만 바꾼다.
+static void wnaf_add(EC_POINT_PJ* ret_pj, const EC_POINT_AF* tbl, int d)
+{
+    EC_POINT_AF q;
+
+    if (d > 0) {
+        ecadd_jc(ret_pj, ret_pj, &tbl[d >> 1]);
+    } else {
+        set_bn(&q.x, &tbl[(-d) >> 1].x);
+        subp(&q.y, &zero, &tbl[(-d) >> 1].y);
+        q.is_infty = 0;
+        ecadd_jc(ret_pj, ret_pj, &q);
+    }
+}
+
+/*  scalar multiplication of ec, width-w NAF (variable base, non-constant)
+    홀수배 P, 3P, ..., (2^{w-1} - 1)P 를 wnaf_table 로 만든다. (Co-Z 덧셈, 역원 1번)
+    음수 자리는 y 부호만 바꿔서 더한다. 0 이 이어지는 구간은 ecdbl_jc_n 으로 한번에 doubling.
+    w 는 2 .. ECC_WNAF_WMAX, 범위 밖이면 가까운 값을 쓴다. 덧셈은 약 256 / (w + 1) 번. */
+void ecsm_wnaf(EC_POINT_AF* point_r, const EC_POINT_AF* point_G, const BN* scalar, int w)
+{
+    int8_t naf[BITS256 + 1];
+    EC_POINT_AF tbl[1 << (ECC_WNAF_WMAX - 2)];
+    EC_POINT_PJ ret_pj = {0};
+    int len = 0, run = 0;
+
+    if (w < 2) w = 2;
+    if (w > ECC_WNAF_WMAX) w = ECC_WNAF_WMAX;
+
+    if (point_G->is_infty) {
+        point_r->is_infty = 1;
+        return;
+    }
+
+    wnaf_table(tbl, point_G, 1 << (w - 2));
+    len = wnaf_recode(naf, scalar, w);
+
+    ret_pj.is_infty = 1;
+    for (int i = len - 1; i >= 0; i--) {
+        run++;
+        if (naf[i] == 0) continue;
+
+        ecdbl_jc_n(&ret_pj, &ret_pj, run);
+        run = 0;
+        wnaf_add(&ret_pj, tbl, naf[i]);
+    }
+    ecdbl_jc_n(&ret_pj, &ret_pj, run);
+
+    jc2af(point_r, &ret_pj);
+}
+
+/*  u1 G + u2 Q (Shamir / Straus), 서명 검증용 (non-constant)
+    u1 은 width-ECC_DSM_WG NAF 로 미리 만든 G 의 홀수배 표를, u2 는 width-ECC_DSM_WQ NAF 로 호출마다 만드는 Q 의 표를 쓴다.
+    두 NAF 를 위에서부터 같이 읽어서 더블링 (약 256번) 과 마지막 affine 변환 (역원 1번) 을 공유한다.
+    덧셈은 약 256 / (WG + 1) + 256 / (WQ + 1) 번. G 표는 처음 쓸 때 (또는 ecsm_double_init 에서) 만든다. */
+static EC_POINT_AF dsm_g_tbl[1 << (ECC_DSM_WG - 2)];
+static int dsm_ready = 0;
+
+void ecsm_double_init(void)
+{
+    if (dsm_ready) return;
+
+    wnaf_table(dsm_g_tbl, &fix_g_ltr[1], 1 << (ECC_DSM_WG - 2));
+    dsm_ready = 1;
+}
+
+void ecsm_double(EC_POINT_AF* point_r, const BN* u1, const EC_POINT_AF* point_q, const BN* u2)
+{
+    int8_t naf1[BITS256 + 1] = {0}, naf2[BITS256 + 1] = {0};
+    EC_POINT_AF q_tbl[1 << (ECC_DSM_WQ - 2)];
+    EC_POINT_PJ ret_pj = {0};
+    int len = 0, len2 = 0, run = 0;
+
+    if (!dsm_ready) ecsm_double_init();
+
+    len = wnaf_recode(naf1, u1, ECC_DSM_WG);
+    if (!point_q->is_infty) {
+        wnaf_table(q_tbl, point_q, 1 << (ECC_DSM_WQ - 2));
+        len2 = wnaf_recode(naf2, u2, ECC_DSM_WQ);
+        if (len2 > len) len = len2;
+    }
+
+    ret_pj.is_infty = 1;
+    for (int i = len - 1; i >= 0; i--) {
+        run++;
+        if ((naf1[i] | naf2[i]) == 0) continue;
+
+        ecdbl_jc_n(&ret_pj, &ret_pj, run);
+        run = 0;
+        if (naf1[i]) wnaf_add(&ret_pj, dsm_g_tbl, naf1[i]);
+        if (naf2[i]) wnaf_add(&ret_pj, q_tbl, naf2[i]);
+    }
+    ecdbl_jc_n(&ret_pj, &ret_pj, run);
+
+    jc2af(point_r, &ret_pj);
+}
+
+/*  sum scalars[i] points[i] (Pippenger, bucket method, non-constant)
+    스칼라를 c 비트씩 부호 있는 자리 d (|d| <= 2^{c-1}) 로 나누고, window 마다 점을 |d| 번 bucket 에 넣는다. (d < 0 이면 -P)
+        window 합 = sum_j j B_j = running sum (B_top + ... + B_j 를 누적해서 다시 더함)
+        전체 = sum W_k 2^{ck} (Horner)
+    bucket 안의 덧셈은 affine 으로 한다: 모든 bucket 의 점을 둘씩 짝지어 더하는 단계마다 분모를 모아서 inv_batch 로 역원 한번 (montgomery's trick).
+    점 하나당 덧셈 비용은 약 1I / m + 6M (m 은 단계의 덧셈 개수). 단계는 log2(bucket 크기) 번.
+    c 는 (window 수) (n + 2^{c+1}) 이 가장 작게 되도록 n 에서 고른다. (bucket 덧셈 1 : running sum 4 정도)
+    메모리는 점 n 개 기준 약 (2 EC_POINT_AF + BN + 9 바이트) n, 할당 실패면 -1 리턴. */
+#define MSM_CMAX 16
+
+typedef struct {
+    BN* den;            // 분모
+    BN* inv;            // 1 / den[i] (inv_batch)
+    uint8_t* kind;      // 0: 덧셈, 1: doubling, 2: 결과가 무한원점
+} MSM_BATCH;
+
+static int msm_window(size_t n)
+{
+    double cost = 0, best = 0;
+    int c_best = 1;
+
+    for (int c = 1; c <= MSM_CMAX; c++) {
+        cost = (double)(BITS256 / c + 1) * ((double)n + (double)(2u << c));
+        if (c == 1 || cost < best) {
+            best = cost;
+            c_best = c;
+        }
+    }
+    return c_best;
+}
+
+// 스칼라의 pos 번째 비트부터 c 비트 (256 이상은 0)
+static uint32_t msm_bits(const BN* scalar, int pos, int c)
+{
+    uint64_t t = 0;
+
+    if (pos >= BITS256) return 0;
+    t = scalar->v[pos / WORDBITS];
+    if (pos / WORDBITS + 1 < NUMWORD) t |= (uint64_t)scalar->v[pos / WORDBITS + 1] << WORDBITS;
+    return (uint32_t)(t >> (pos % WORDBITS)) & ((1u << c) - 1);
+}
 
+/*  lst[start[b] ..] 의 len[b] 개 점을 둘씩 더해서 앞쪽에 다시 쓴다. 무한원점이 된 결과는 버린다.
+    모든 bucket 의 길이가 1 이하가 될 때까지 반복. 점은 field engine domain 의 affine */
+static void msm_reduce(EC_POINT_AF* lst, const size_t* start, size_t* len, size_t nb, MSM_BATCH* bt)
+{
+    BN t, u, lam;
+    const EC_POINT_AF *p, *q;
+    size_t m = 0, out = 0, half = 0;
+    int again = 1;
+
+    while (again) {
+        again = 0;
+
+        // 분모: x2 - x1, 같은 점이면 2y1, P = -Q 이면 1 (결과 무한원점)
+        m = 0;
+        for (size_t b = 0; b < nb; b++) {
+            for (size_t i = 0; i + 1 < len[b]; i += 2) {
+                p = &lst[start[b] + i];
+                q = &lst[start[b] + i + 1];
+                subp(&bt->den[m], &q->x, &p->x);
+                bt->kind[m] = 0;
+                if (!ucmp(&bt->den[m], &zero)) {
+                    if (!ucmp(&p->y, &q->y)) {
+                        addp(&bt->den[m], &p->y, &p->y);
+                        bt->kind[m] = 1;
+                    } else {
+                        set_bn(&bt->den[m], &fe_one);
+                        bt->kind[m] = 2;
+                    }
+                }
+                m++;
+            }
+        }
+        if (m == 0) break;
+
+        inv_batch(bt->inv, bt->den, m);
+
+        // lambda = (y2 - y1) / (x2 - x1) 또는 (3x1^2 - 3) / 2y1, x3 = lambda^2 - x1 - x2, y3 = lambda (x1 - x3) - y1
+        // 결과 j 는 lst[start + out] (out <= i) 에 쓰므로 아직 읽지 않은 점을 덮지 않는다
+        m = 0;
+        for (size_t b = 0; b < nb; b++) {
+            if (len[b] < 2) continue;
+
+            out = 0;
+            half = len[b] / 2;
+            for (size_t i = 0; i + 1 < len[b]; i += 2, m++) {
+                EC_POINT_AF* r = &lst[start[b] + out];
+                p = &lst[start[b] + i];
+                q = &lst[start[b] + i + 1];
+                if (bt->kind[m] == 2) continue;
+
+                if (bt->kind[m] == 0) {
+                    subp(&t, &q->y, &p->y);
+                } else {
+                    sqrp_fe(&t, &p->x);
+                    subp(&t, &t, &fe_one);
+                    addp(&lam, &t, &t);
+                    addp(&t, &lam, &t);
+                }
+                mulp_fe(&lam, &t, &bt->inv[m]);
+
+                sqrp_fe(&t, &lam);
+                subp(&t, &t, &p->x);
+                subp(&t, &t, &q->x);
+                subp(&u, &p->x, &t);
+                mulp_fe(&u, &u, &lam);
+                subp(&r->y, &u, &p->y);
+                set_bn(&r->x, &t);
+                r->is_infty = 0;
+                out++;
+            }
 
+            // 홀수개면 마지막 점을 그대로 옮긴다
+            if (len[b] & 1) set_ec_point_af(&lst[start[b] + out++], &lst[start[b] + 2 * half]);
+            len[b] = out;
+            if (out > 1) again = 1;
+        }
+    }
+}
 
-/*  LtoR, RtoL은 non-constant --> 몽고메리래더 알고리즘을 사용. 
-    몽고메리 래더는 병렬연산이 가능하다는 장점이 있다. */
-// void ecsm_mont(EC_POINT_AF *point_r, const EC_POINT_AF *point_g, const BN* scalar) 
-// {
-//     EC_POINT_PJ left = {0};
-//     EC_POINT_PJ right = {0};
+int ecsm_multi(EC_POINT_AF* point_r, const BN* scalars, const EC_POINT_AF* points, size_t n)
+{
+    EC_POINT_PJ win[BITS256 + 1];       // window 합, c = 1 이면 257 개
+    EC_POINT_PJ acc = {0}, sum = {0};
+    EC_POINT_AF* pts = NULL;            // field engine domain
+    EC_POINT_AF* lst = NULL;
+    int32_t* dig = NULL;
+    uint8_t* carry = NULL;
+    size_t *start = NULL, *len = NULL, *fill = NULL;
+    MSM_BATCH bt = {0};
+    size_t nb = 0, pos = 0;
+    int c = 0, nw = 0, ret = -1;
+    int32_t d = 0;
+
+    point_r->is_infty = 1;
+    if (n == 0) return 0;
+
+    c = msm_window(n);
+    nw = BITS256 / c + 1;
+    nb = (size_t)1 << (c - 1);          // bucket j - 1 에 |d| = j 인 점
+
+    pts = (EC_POINT_AF*)malloc(n * sizeof(EC_POINT_AF));
+    lst = (EC_POINT_AF*)malloc(n * sizeof(EC_POINT_AF));
+    dig = (int32_t*)malloc(n * sizeof(int32_t));
+    carry = (uint8_t*)calloc(n, 1);
+    start = (size_t*)malloc((nb + 1) * sizeof(size_t));
+    len = (size_t*)malloc(nb * sizeof(size_t));
+    fill = (size_t*)malloc(nb * sizeof(size_t));
+    bt.den = (BN*)malloc((n / 2 + 1) * sizeof(BN));
+    bt.inv = (BN*)malloc((n / 2 + 1) * sizeof(BN));
+    bt.kind = (uint8_t*)malloc(n / 2 + 1);
+    if (!pts || !lst || !dig || !carry || !start || !len || !fill || !bt.den || !bt.inv || !bt.kind) goto end;
+
+    for (size_t i = 0; i < n; i++) af2fe(&pts[i], &points[i]);
+
+    // window 를 아래에서부터 (부호 있는 자리의 올림 때문에)
+    for (int w = 0; w < nw; w++)
+    {
+        // 자리 계산과 bucket 크기 (counting sort)
+        for (size_t b = 0; b < nb; b++) len[b] = 0;
+        for (size_t i = 0; i < n; i++) {
+            d = (int32_t)(msm_bits(&scalars[i], w * c, c) + carry[i]);
+            carry[i] = (d > (1 << (c - 1)));
+            if (carry[i]) d -= (1 << c);
+            if (pts[i].is_infty) d = 0;
+            dig[i] = d;
+            if (d) len[(d < 0 ? -d : d) - 1]++;
+        }
+        start[0] = 0;
+        for (size_t b = 0; b < nb; b++) {
+            start[b + 1] = start[b] + len[b];
+            fill[b] = start[b];
+        }
+        for (size_t i = 0; i < n; i++) {
+            if (dig[i] == 0) continue;
+            pos = fill[(dig[i] < 0 ? -dig[i] : dig[i]) - 1]++;
+            set_ec_point_af(&lst[pos], &pts[i]);
+            if (dig[i] < 0) subp(&lst[pos].y, &zero, &lst[pos].y);
+        }
 
-//     // init : left = infty, right = G
-//     af2jc(&right, point_g);
+        msm_reduce(lst, start, len, nb, &bt);
 
-//     // run montgomery ladder
-//     for(int i = NUMWORD - 1; i >= 0; i--) 
-//     {
-//         for (int j = WORDBITS - 1; j >= 0; j--) 
-//         {
-//             if ((scalar->v[i] >> j) & 1) 
-//             {
-//                 ecadd_af(&left, &left, &right); //? j = j + a --> a가 아핀이 아닌데요?
-//                 ecdbl_jc(&right, &right);
-//             } 
-//             else 
-//             {
-//                 ecadd_jc(&right, &right, &left);
-//                 ecdbl_jc(&left, &left);
-//             }
-//         }
-//     }
+        // W = sum (b + 1) B_b: acc = B_top + ... + B_b, sum += acc
+        acc.is_infty = 1;
+        sum.is_infty = 1;
+        for (size_t b = nb; b-- > 0; ) {
+            if (len[b]) ecadd_jc(&acc, &acc, &lst[start[b]]);
+            ecadd_jj(&sum, &sum, &acc);
+        }
+        set_ec_point_pj(&win[w], &sum);
+    }
 
-//     /*
-//         mix 좌표계가 안되는데 어떻게 할까?
-//         1. 될수있는 기가막힌 아이디어가 있을 수 있다.
-//         2. 그냥 mix 없이 자코비안 좌표 혹은 아핀 좌표만을 사용한다. 
-//     */
-// }
+    // sum W_w 2^{cw}
+    set_ec_point_pj(&acc, &win[nw - 1]);
+    for (int w = nw - 2; w >= 0; w--) {
+        ecdbl_jc_n(&acc, &acc, c);
+        ecadd_jj(&acc, &acc, &win[w]);
+    }
+    jc2af(point_r, &acc);
+    ret = 0;
+
+end:
+    free(pts);
+    free(lst);
+    free(dig);
+    free(carry);
+    free(start);
+    free(len);
+    free(fill);
+    free(bt.den);
+    free(bt.inv);
+    free(bt.kind);
+    return ret;
+}
 
+// test.c 와 같이 링크할 때는 -DECC_LIB_NO_MAIN
+#ifndef ECC_LIB_NO_MAIN
 int main(void)
 {
     const BN k = {
@@ -451,6 +1577,7 @@ int main(void)
 
     return 0;
 }
+#endif
 
 /*
 
@@ -1,8 +1,10 @@
 /*______________________________________________________________
     ecadd_af : 1I + 2M + 1S + 6A
     ecdbl_af : 1I + 2M + 2S + 7A
-    ecdbl_jc :      4M + 4S + 9A + 1F --- 지금은 1F 대신 1M 을 사용. 바꿀 필요 있음. 9A = 5A + 3C
+    ecdbl_jc :      3M + 3S + 1F + 10A --- a = -3 (dbl-2001-b), 1F = ab - cd (reduction 한번), 반으로 나누기 없음
     ecadd_jc :      8M + 3S + 7A --- 7A = 6A + 1C
+    ecadd_hp :     12M + 2Mb + 29A --- complete (RCB), 예외 처리 없음
+    ecdbl_hp :      8M + 3S + 2Mb + 21A
 ________________________________________________________________
     1I = 15M , 1S = 0.8M 1A = 0.8M 이라고 가정.
     이건 승주 알고리즘에서 따온거임. //todo 실제로 내 알고리즘에서 inv는 mulp_mont의 몇배? add는 어느정도 걸리지?
@@ -18,6 +20,11 @@ ________________________________________________________________
     RtoL      : 256dbl_af + 128add_jc -- LtoR이랑 같지만, RtoL은 mix좌표계 사용 불가능. 따라서 더블링을 af으로 사용.
     LtoR_prec : 256dbl_jc +  32add_jc (256개의 좌표 저장) -- k를 8비트씩 읽음. 0이라 안더할 확률은 적으므로 무조건 덧셈이 있다고 가정.
     RtoL_prec :           + 128add_jc (256개의 좌표 저장) -- 더블링하는 G가 고정이므로 전부 사전계산했음/
+    Comb      :  32dbl_jc +  32add_jc (256개의 좌표 저장) -- 8 x 1 comb, ECC_COMB_TEETH / ECC_COMB_BLOCKS 로 조절
+    CT window : 255dbl_jc +  51add_jc ( 16개의 좌표 저장) -- w = 5, 상수 시간. 덧셈마다 표 전체를 마스크로 읽음
+    Double    : 256dbl_jc +  28add_jc +  43add_jc -- u1 G + u2 Q, G 는 w = 8 (표 64개), Q 는 w = 5, 더블링/역원 공유
+    Multi     : (256/c + 1) (n affine add + 2^{c-1} (add_jc + add_jj)) + 256dbl_jc -- Pippenger, 점 n 개, c 는 n 에서 고름
+    wNAF      : 256dbl_jc + 256/(w+1) add_jc + 표 2^{w-2}개 (Co-Z 덧셈 + 역원 1번) -- 임의의 점, w = 5 이면 덧셈 약 43번
 ________________________________________________________________
     모두 M으로 치환하여 상대적으로 몇배 걸리는지 확인해보자.
 
@@ -30,11 +37,53 @@ ________________________________________________________________
     //todo for문에서만 따로 계산해봐야겠음.
 ________________________________________________________________*/
 
+#ifndef ECC_LIB_H
+#define ECC_LIB_H
+
 #include "arith_lib.h"
 
 #define BITS256 256
 #define WORDBITS 32
 
+// ecsm_wnaf 의 최대 window 크기 (홀수배 표 2^{w-2} 개)
+#ifndef ECC_WNAF_WMAX
+#define ECC_WNAF_WMAX 6
+#endif
+
+/*  ecsm_comb (Lim-Lee) 설정: 스칼라를 TEETH 행 x ceil(256 / TEETH) 열로 놓고 열을 BLOCKS 개로 나눈다.
+    표는 BLOCKS x 2^TEETH 점, 더블링 ceil(256 / TEETH / BLOCKS) 번, 덧셈 약 256 / TEETH 번.
+    예) 4 x 1: 표 16개, 64dbl + 64add / 8 x 1: 표 256개, 32dbl + 32add / 8 x 2: 표 512개, 16dbl + 32add */
+#ifndef ECC_COMB_TEETH
+#define ECC_COMB_TEETH 8
+#endif
+#ifndef ECC_COMB_BLOCKS
+#define ECC_COMB_BLOCKS 1
+#endif
+#if ECC_COMB_TEETH < 1 || ECC_COMB_TEETH > 8 || ECC_COMB_BLOCKS < 1
+#error "ECC_COMB_TEETH 는 1 .. 8, ECC_COMB_BLOCKS 는 1 이상"
+#endif
+#define ECC_COMB_COLS   ((BITS256 + ECC_COMB_TEETH - 1) / ECC_COMB_TEETH)                 // 행 하나의 비트 수
+#define ECC_COMB_SPAN   ((ECC_COMB_COLS + ECC_COMB_BLOCKS - 1) / ECC_COMB_BLOCKS)        // 블록 하나의 열 수 (= 더블링 횟수)
+
+// ecsm_double 의 window 크기: G 는 미리 만드는 표 2^{WG-2} 개, Q 는 호출마다 만드는 표 2^{WQ-2} 개
+#ifndef ECC_DSM_WG
+#define ECC_DSM_WG 8
+#endif
+#ifndef ECC_DSM_WQ
+#define ECC_DSM_WQ 5
+#endif
+#if ECC_DSM_WG < 2 || ECC_DSM_WG > 8 || ECC_DSM_WQ < 2 || ECC_DSM_WQ > ECC_WNAF_WMAX
+#error "ECC_DSM_WG 는 2 .. 8 (자리는 int8_t), ECC_DSM_WQ 는 2 .. ECC_WNAF_WMAX"
+#endif
+
+// ecsm_ct 의 window 크기: 자리 257 / w + 1 개, 홀수배 표 2^{w-1} 개
+#ifndef ECC_CT_W
+#define ECC_CT_W 5
+#endif
+#if ECC_CT_W < 2 || ECC_CT_W > 7
+#error "ECC_CT_W 는 2 .. 7"
+#endif
+
 typedef struct {
     BN x, y;
     uint32_t is_infty;
@@ -45,8 +94,35 @@ typedef struct {
     uint32_t is_infty;
 } EC_POINT_PJ;
 
+// homogeneous projective: (X:Y:Z) --> (X/Z, Y/Z), 무한원점은 (0:1:0) 이므로 is_infty 가 없다
+typedef struct {
+    BN x, y, z;
+} EC_POINT_HP;
+
 // coefficient of a
 static const BN coef_a = {0xfffffffc, 0xffffffff, 0xffffffff, 0x00000000, 0x00000000, 0x00000000, 0x00000001, 0xffffffff};
+// coefficient of b
+static const BN coef_b = {0x27d2604b, 0x3bce3c3e, 0xcc53b0f6, 0x651d06b0, 0x769886bc, 0xb3ebbd55, 0xaa3a93e7, 0x5ac635d8};
+
+void set_ec_point_af(EC_POINT_AF *dest, const EC_POINT_AF* src);
+void set_ec_point_pj(EC_POINT_PJ *dest, const EC_POINT_PJ* src);
+void ec_normalize_batch(EC_POINT_AF* out, const EC_POINT_PJ* in, size_t n, BN* tmp);
+
+void ecsm_ltr(EC_POINT_AF* point_r, const EC_POINT_AF* point_G, const BN* scalar);
+void ecsm_rtl(EC_POINT_AF* point_r, const EC_POINT_AF* point_G, const BN* scalar);
+void ecsm_ltr_precomp(EC_POINT_AF* point_r, const EC_POINT_AF* point_G, const BN* scalar);
+void ecsm_rtl_precomp(EC_POINT_AF* point_r, const EC_POINT_AF* point_G, const BN* scalar);
+void ecsm_precomp_init(void);
+void ecsm_complete(EC_POINT_AF* point_r, const EC_POINT_AF* point_G, const BN* scalar);
+void ecsm_ladder(EC_POINT_AF* point_r, const EC_POINT_AF* point_G, const BN* scalar);
+void ecsm_wnaf(EC_POINT_AF* point_r, const EC_POINT_AF* point_G, const BN* scalar, int w);
+void ecsm_comb_init(void);
+void ecsm_comb(EC_POINT_AF* point_r, const EC_POINT_AF* point_G, const BN* scalar);
+void ecsm_ct_init(void);
+void ecsm_ct(EC_POINT_AF* point_r, const EC_POINT_AF* point_G, const BN* scalar);
+void ecsm_double_init(void);
+void ecsm_double(EC_POINT_AF* point_r, const BN* u1, const EC_POINT_AF* point_q, const BN* u2);
+int ecsm_multi(EC_POINT_AF* point_r, const BN* scalars, const EC_POINT_AF* points, size_t n);
 
 static const EC_POINT_AF fix_g_ltr[256] = {
 {{0}, {0}, 1},
@@ -1073,4 +1149,6 @@ static const EC_POINT_AF fixG_RtoL[256] = {
 {{0x8eb99805, 0x8d93ca69, 0xe99a11e3, 0xad086d4c, 0x0bf33a68, 0xb0c2bf93, 0x02708cfe, 0x01ee7fc2},
 {0x10eeccaf, 0x09fd5f4e, 0x35be799b, 0x811836ea, 0xf3455711, 0x124be02e, 0x1b024882, 0x9655cef0}, 0},
 {{0x375f2b54, 0xb52dec8f, 0xe3e92350, 0x4efe3560, 0x891524bc, 0x5066e911, 0x2e6b2313, 0x77b20a91},
-{0xd6cc67ff, 0xcaa801fc, 0xe850e0f1, 0xdf623da1, 0xdd038a72, 0xf7b10bfc, 0x25cea3f7, 0xa3dc2918}, 0}};
\ No newline at end of file
+{0xd6cc67ff, 0xcaa801fc, 0xe850e0f1, 0xdf623da1, 0xdd038a72, 0xf7b10bfc, 0x25cea3f7, 0xa3dc2918}, 0}};
+
+#endif
\ No newline at end of file
@@ -10,20 +10,38 @@ const BN nistp256[5] = {
     {0xfffffffc, 0xffffffff, 0xffffffff, 0x00000003,
      0x00000000, 0x00000000, 0x00000004, 0xfffffffc},
     {0xfffffffb, 0xffffffff, 0xffffffff, 0x00000004,
-     0x00000000d, 0x00000000, 0x00000005, 0xfffffffb}};
+     0x00000000, 0x00000000, 0x00000005, 0xfffffffb}};
 
 const BN P_prime = {
     0x00000001, 0x00000000, 0x00000000, 0x00000001, 
     0x00000000, 0x00000000, 0x00000002, 0xFFFFFFFF};
 
+// R mod p = montgomery domain의 1
 const BN RmodP = {
-    0x00000003, 0x00000000, 0xFFFFFFFF ,0xFFFFFFFB, 
-    0xFFFFFFFE, 0xFFFFFFFF, 0xFFFFFFFD, 0x00000004};
+    0x00000001, 0x00000000, 0x00000000, 0xFFFFFFFF, 
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFE, 0x00000000};
+
+// R^2 mod p
 
 const BN RRmodP = {
     0x00000003, 0x00000000, 0xFFFFFFFF ,0xFFFFFFFB, 
     0xFFFFFFFE, 0xFFFFFFFF, 0xFFFFFFFD, 0x00000004};
 
+/*  limb 단위로 쓰는 내부 함수용: ECC_LIMB64 이면 64비트 limb (d), 아니면 32비트 limb (v) */
+#ifdef ECC_LIMB64
+typedef uint64_t    limb_t;
+typedef uint128_t   dlimb_t;
+#define LIMB_BITS   64
+#define NUMLIMB     NUMDWORD
+#define LIMBS(x)    ((x)->d)
+#else
+typedef uint32_t    limb_t;
+typedef uint64_t    dlimb_t;
+#define LIMB_BITS   32
+#define NUMLIMB     NUMWORD
+#define LIMBS(x)    ((x)->v)
+#endif
+
 /* BN deep copy */
 //todo void set_bn(BN* dest, const int32_t* src)
 //todo void _bn(BN* dest, const int32_t* src)
@@ -35,25 +53,72 @@ void set_bn(BN* dest, const BN* src)
     dest->s = src->s;
 }
 
-/* compare function: memcmp는 하위 워드부터 비교하므로 따로 구현함 */
+/* conditional copy: mask가 0xffffffff이면 dest = src, 0이면 그대로. 분기 없이 동작 */
+void cset_bn(BN* dest, const BN* src, uint32_t mask)
+{
+    for (int i = 0; i < NUMWORD; i++) {
+        dest->v[i] ^= (dest->v[i] ^ src->v[i]) & mask;
+    }
+}
+
+/* conditional swap: mask가 0xffffffff이면 a, b 를 맞바꿈, 0이면 그대로. 분기 없이 동작 */
+void cswap_bn(BN* a, BN* b, uint32_t mask)
+{
+    uint32_t t = 0;
+
+    for (int i = 0; i < NUMWORD; i++) {
+        t = (a->v[i] ^ b->v[i]) & mask;
+        a->v[i] ^= t;
+        b->v[i] ^= t;
+    }
+}
+
+/* compare function: memcmp는 하위 워드부터 비교하므로 따로 구현함
+   a - b 와 b - a 의 최종 빌림만 보고 판단한다. 분기 없이 동작 */
 int32_t ucmp(const BN* opa, const BN* opb) {
-    for (int i = NUMWORD - 1; i >= 0; i--) {
-        if (opa->v[i] > opb->v[i]) return 1;        // opa > opb
-        if (opa->v[i] < opb->v[i]) return -1;       // opa < opb
+    uint32_t lt = 0, gt = 0;
+
+#ifdef ECC_LIMB64
+    uint128_t t = 0;
+
+    for (int i = 0; i < NUMDWORD; i++) {
+        t = (uint128_t)opa->d[i] - opb->d[i] - lt;
+        lt = (uint32_t)(t >> 64) & 1;
+        t = (uint128_t)opb->d[i] - opa->d[i] - gt;
+        gt = (uint32_t)(t >> 64) & 1;
     }
-    return 0;   // opa = opb
+#else
+    uint64_t t = 0;
+
+    for (int i = 0; i < NUMWORD; i++) {
+        t = (uint64_t)opa->v[i] - opb->v[i] - lt;
+        lt = (uint32_t)(t >> 32) & 1;
+        t = (uint64_t)opb->v[i] - opa->v[i] - gt;
+        gt = (uint32_t)(t >> 32) & 1;
+    }
+#endif
+    return (int32_t)gt - (int32_t)lt;   // opa > opb : 1, opa = opb : 0, opa < opb : -1
 }
 
-/* ret = opa >> 1 */
+/* ret = opa >> 1, 상위 워드의 최하위 비트를 아래 워드의 최상위 비트로 넘김 */
 uint32_t rshift1(BN* ret, const BN* opa)
 {
     BN r;
     uint32_t carry = 0;
 
+#ifdef ECC_LIMB64
+    for (int i = 0; i < NUMDWORD - 1; i++) {
+        r.d[i] = (opa->d[i] >> 1) | (opa->d[i + 1] << 63);
+    }
+    r.d[NUMDWORD - 1] = opa->d[NUMDWORD - 1] >> 1;
+    carry = (opa->v[0] & 1) << 31;
+#else
     for (int i = NUMWORD - 1; i >= 0; i--) {
         r.v[i] = (opa->v[i] >> 1) ^ carry;       // 1 right shift
         carry = (opa->v[i] & 1) << 31;           // carry
     }
+#endif
+    r.s = opa->s;
 
     set_bn(ret, &r);
 
@@ -66,11 +131,24 @@ uint32_t uadd(BN* ret, const BN* opa, const BN* opb)
     BN r = {0};
     uint32_t carry = 0;
 
+#ifdef ECC_LIMB64
+    uint128_t t = 0;
+
+    for(size_t i = 0; i < NUMDWORD; i++) {
+        t = (uint128_t)opa->d[i] + opb->d[i] + carry;           // addition
+        r.d[i] = (uint64_t)t;
+        carry = (uint32_t)(t >> 64);                             // carry
+    }
+#else
+    uint64_t t = 0;
+
+    // 64비트 합의 상위 32비트가 캐리: 비교/분기 없음
     for(size_t i = 0; i < NUMWORD; i++) {
-        r.v[i] = opa->v[i] + opb->v[i] + carry;                  // addition
-        carry = (opa->v[i] + opb->v[i] + carry < carry) +       // carry condition 1
-              (opa->v[i] + opb->v[i] < opa->v[i]);              // carry condition 2
+        t = (uint64_t)opa->v[i] + opb->v[i] + carry;            // addition
+        r.v[i] = (uint32_t)t;
+        carry = (uint32_t)(t >> 32);                             // carry
     }
+#endif
 
     set_bn(ret, &r);
  
@@ -83,45 +161,113 @@ uint32_t usub(BN* ret, const BN* opa, const BN* opb)
     BN r;
     uint32_t carry = 0;
 
+#ifdef ECC_LIMB64
+    uint128_t t = 0;
+
+    for (int i = 0; i < NUMDWORD; i++) {
+        t = (uint128_t)opa->d[i] - opb->d[i] - carry;           // substraction
+        r.d[i] = (uint64_t)t;
+        carry = (uint32_t)(t >> 64) & 1;                         // borrow: 음수이면 상위 비트가 전부 1
+    }
+#else
+    uint64_t t = 0;
+
     for (int i = 0; i < NUMWORD; i++) {
-        r.v[i] = opa->v[i] - opb->v[i] - carry;                 // substraction
-        carry = (opa->v[i] < opb->v[i]) ||                      // carry condition 1
-              ((opa->v[i] == opb->v[i]) && (carry == 1));       // carry condition 2
+        t = (uint64_t)opa->v[i] - opb->v[i] - carry;            // substraction
+        r.v[i] = (uint32_t)t;
+        carry = (uint32_t)(t >> 32) & 1;                         // borrow: 음수이면 상위 비트가 전부 1
     }
+#endif
     
     set_bn(ret, &r);
 
     return carry;
 }
 
-/* ret = opa + opb mod p */
+/* ret = opa + opb mod p
+   r - p 를 항상 계산해두고, 캐리가 있거나 r >= p (빌림 없음) 이면 마스크로 골라씀. 분기 없이 동작 */
 void addp(BN* ret, const BN* opa, const BN* opb) 
 {
-    BN r;
-    uint32_t carry = 0;
+    uint32_t carry = 0, borrow = 0;
 
-    carry = uadd(&r, opa, opb);
+#ifdef ECC_LIMB64
+    uint64_t r[NUMDWORD], r_sub[NUMDWORD], mask = 0;
+    uint128_t t = 0;
 
-    if (carry == 1 || ucmp(&r, &P) >= 0) {
-        usub(&r, &r, &P);
+    for (int i = 0; i < NUMDWORD; i++) {
+        t = (uint128_t)opa->d[i] + opb->d[i] + carry;
+        r[i] = (uint64_t)t;
+        carry = (uint32_t)(t >> 64);
     }
+    for (int i = 0; i < NUMDWORD; i++) {
+        t = (uint128_t)r[i] - P.d[i] - borrow;
+        r_sub[i] = (uint64_t)t;
+        borrow = (uint32_t)(t >> 64) & 1;
+    }
+    mask = 0 - (uint64_t)(carry | (borrow ^ 1));
+    for (int i = 0; i < NUMDWORD; i++) {
+        ret->d[i] = r[i] ^ ((r[i] ^ r_sub[i]) & mask);
+    }
+#else
+    uint32_t r[NUMWORD], r_sub[NUMWORD], mask = 0;
+    uint64_t t = 0;
 
-    set_bn(ret, &r);
+    for (int i = 0; i < NUMWORD; i++) {
+        t = (uint64_t)opa->v[i] + opb->v[i] + carry;
+        r[i] = (uint32_t)t;
+        carry = (uint32_t)(t >> 32);
+    }
+    for (int i = 0; i < NUMWORD; i++) {
+        t = (uint64_t)r[i] - P.v[i] - borrow;
+        r_sub[i] = (uint32_t)t;
+        borrow = (uint32_t)(t >> 32) & 1;
+    }
+    mask = 0 - (carry | (borrow ^ 1));
+    for (int i = 0; i < NUMWORD; i++) {
+        ret->v[i] = r[i] ^ ((r[i] ^ r_sub[i]) & mask);
+    }
+#endif
+    ret->s = opa->s;
 }
 
-/* ret = opa - opb mod p */
+/* ret = opa - opb mod p
+   빌림이 있으면 p, 없으면 0 을 더함 (p & mask). 분기 없이 동작 */
 void subp(BN *ret, const BN* opa, const BN* opb) 
 {
-    BN r;
-    uint32_t carry = 0;
+    uint32_t carry = 0, borrow = 0;
 
-    carry = usub(&r, opa, opb);
+#ifdef ECC_LIMB64
+    uint64_t r[NUMDWORD], mask = 0;
+    uint128_t t = 0;
 
-    if (carry == 1) {
-        uadd(&r, &r, &P);
+    for (int i = 0; i < NUMDWORD; i++) {
+        t = (uint128_t)opa->d[i] - opb->d[i] - borrow;
+        r[i] = (uint64_t)t;
+        borrow = (uint32_t)(t >> 64) & 1;
+    }
+    mask = 0 - (uint64_t)borrow;
+    for (int i = 0; i < NUMDWORD; i++) {
+        t = (uint128_t)r[i] + (P.d[i] & mask) + carry;
+        ret->d[i] = (uint64_t)t;
+        carry = (uint32_t)(t >> 64);
     }
+#else
+    uint32_t r[NUMWORD], mask = 0;
+    uint64_t t = 0;
 
-    set_bn(ret, &r);
+    for (int i = 0; i < NUMWORD; i++) {
+        t = (uint64_t)opa->v[i] - opb->v[i] - borrow;
+        r[i] = (uint32_t)t;
+        borrow = (uint32_t)(t >> 32) & 1;
+    }
+    mask = 0 - borrow;
+    for (int i = 0; i < NUMWORD; i++) {
+        t = (uint64_t)r[i] + (P.v[i] & mask) + carry;
+        ret->v[i] = (uint32_t)t;
+        carry = (uint32_t)(t >> 32);
+    }
+#endif
+    ret->s = opa->s;
 }
 
 /*  R = A^2 product scanning
@@ -129,6 +275,44 @@ void subp(BN *ret, const BN* opa, const BN* opb)
     ex. uv = a2*a0 + a1*a1 + a0*a2 의 경우 a0*a2 = a2*a0이므로 한 번만 곱셈 후 시프트. */
 void usqr_ps(BN2* ret, const BN* opa)
 {
+#ifdef ECC_LIMB64
+    uint64_t r2 = 0, r1 = 0, r0 = 0, c1 = 0, c2 = 0;
+    uint128_t uv = 0;
+    uint64_t u = 0, v = 0;
+
+    for (int k = 0; k < 2*NUMDWORD-1; k++) 
+    {
+        for(int i = 0, j = k; i <= k; i++, j--) 
+        {
+            if (i >= NUMDWORD || j >= NUMDWORD || j < i) continue;
+
+            // uv 계산. 중복되는 부분은 시프트로.
+            uv = (uint128_t)opa->d[i] * opa->d[j];
+            if (i < j) {
+                r2 += (uint64_t)(uv >> 127);
+                uv = uv << 1;
+            }
+            v = (uint64_t)uv;
+            u = (uint64_t)(uv >> 64);
+
+            // uv를 계속 r2||r1||r0에 담으면서 더함.
+            r0 += v;
+            c1 = (r0 < v);
+            r1 += u;
+            c2 = (r1 < u);
+            r1 += c1;
+            c2 += (r1 < c1);
+            r2 += c2;
+        }
+
+        // 한칸 올라감.
+        ret->d[k] = r0;
+        r0 = r1;
+        r1 = r2;
+        r2 = 0;
+    }
+    ret->d[2*NUMDWORD-1] = r0;
+#else
     uint32_t r2 = 0, r1 = 0, r0 = 0, c1 = 0, c2 = 0;
     uint64_t uv = 0;
     uint32_t u = 0, v = 0;
@@ -166,6 +350,7 @@ void usqr_ps(BN2* ret, const BN* opa)
         r2 = 0;
     }
     ret->v[2*NUMWORD-1] = r0;
+#endif
 }
 
 /*  R = A * B school book version: 우리가 일반적으로 하는 곱셈과 똑같은 방식으로 진행됨.
@@ -195,6 +380,37 @@ void umul_os(BN2* ret, const BN* opa, const BN* opb)
     자세한 내용은 하단의 #2을 참고. */
 void umul_ps(BN2* ret, const BN* opa, const BN* opb)
 {
+#ifdef ECC_LIMB64
+    uint64_t r2 = 0, r1 = 0, r0 = 0, c1 = 0, c2 = 0;
+    uint128_t uv = 0;
+    uint64_t u = 0, v = 0;
+
+    for (int k = 0; k < 2*NUMDWORD-1; k++) {
+        for(int i = 0, j = k; i <= k; i++, j--) {
+            if (i >= NUMDWORD || j >= NUMDWORD) continue;
+
+            // uv 계산: 64 x 64 = 128비트
+            uv = (uint128_t)opa->d[i] * opb->d[j];
+            v = (uint64_t)uv;
+            u = (uint64_t)(uv >> 64);
+
+            // uv를 r2||r1||r0에 계속 담아주는 작업.
+            r0 += v;
+            c1 = (r0 < v);
+            r1 += u;
+            c2 = (r1 < u);
+            r1 += c1;
+            c2 += (r1 < c1);
+            r2 += c2;
+        }
+        // 한칸 올라감.
+        ret->d[k] = r0;
+        r0 = r1;
+        r1 = r2;
+        r2 = 0;
+    }
+    ret->d[2*NUMDWORD-1] = r0;
+#else
     uint32_t r2 = 0, r1 = 0, r0 = 0, c1 = 0, c2 = 0;
     uint64_t uv = 0;
     uint32_t u = 0, v = 0;
@@ -224,15 +440,210 @@ void umul_ps(BN2* ret, const BN* opa, const BN* opb)
         r2 = 0;
     }
     ret->v[2*NUMWORD-1] = r0;
+#endif
+}
+
+/*______________________________________________________________
+    Karatsuba 곱셈: umul_os / umul_ps 와 같은 BN2 출력
+    a = a1 B + a0, b = b1 B + b0 (limb n개를 반으로, B = 2^{n/2 limb}) 일 때
+        ab = z2 B^2 + z1 B + z0,  z0 = a0 b0,  z2 = a1 b1
+        z1 = z0 + z2 - (a0 - a1)(b0 - b1)
+    (a0 - a1), (b0 - b1) 은 절댓값과 부호 마스크로 계산하므로 반쪽 곱의 입력이 한 비트 늘어나지 않는다.
+    level 만큼 재귀하고 그 아래는 schoolbook. 분기는 길이에만 의존하고 데이터에는 의존하지 않는다.
+        level 1 : 반쪽 곱 3번 (32비트 limb 4x4, 64비트 limb 2x2)
+        level 2 : 반의 반쪽 곱 9번 (32비트 limb 2x2, 64비트 limb 1x1)
+________________________________________________________________*/
+
+static void mul_school(limb_t* r, const limb_t* a, const limb_t* b, int n)
+{
+    dlimb_t uv = 0;
+    limb_t u = 0;
+
+    for (int i = 0; i < 2*n; i++) r[i] = 0;
+    for (int i = 0; i < n; i++) {
+        u = 0;
+        for (int j = 0; j < n; j++) {
+            uv = (dlimb_t)r[i + j] + (dlimb_t)a[i] * b[j] + u;
+            r[i + j] = (limb_t)uv;
+            u = (limb_t)(uv >> LIMB_BITS);
+        }
+        r[i + n] = u;
+    }
+}
+
+/* a_i a_j (i < j) 를 한번씩 곱해서 2배 한 후 대각선 a_i^2 를 더함 */
+static void sqr_school(limb_t* r, const limb_t* a, int n)
+{
+    dlimb_t uv = 0, t = 0;
+    limb_t u = 0, c = 0, top = 0;
+
+    for (int i = 0; i < 2*n; i++) r[i] = 0;
+    for (int i = 0; i < n; i++) {
+        u = 0;
+        for (int j = i + 1; j < n; j++) {
+            uv = (dlimb_t)r[i + j] + (dlimb_t)a[i] * a[j] + u;
+            r[i + j] = (limb_t)uv;
+            u = (limb_t)(uv >> LIMB_BITS);
+        }
+        r[i + n] = u;
+    }
+
+    for (int i = 0; i < 2*n; i++) {
+        top = r[i] >> (LIMB_BITS - 1);
+        r[i] = (r[i] << 1) | c;
+        c = top;
+    }
+
+    c = 0;
+    for (int i = 0; i < n; i++) {
+        uv = (dlimb_t)a[i] * a[i];
+        t = (dlimb_t)r[2*i] + (limb_t)uv + c;
+        r[2*i] = (limb_t)t;
+        c = (limb_t)(t >> LIMB_BITS);
+        t = (dlimb_t)r[2*i + 1] + (limb_t)(uv >> LIMB_BITS) + c;
+        r[2*i + 1] = (limb_t)t;
+        c = (limb_t)(t >> LIMB_BITS);
+    }
+}
+
+/* r = |a - b| (limb n개), a < b 이면 전부 1 인 마스크를 리턴 */
+static limb_t sub_abs(limb_t* r, const limb_t* a, const limb_t* b, int n)
+{
+    dlimb_t t = 0;
+    limb_t borrow = 0, mask = 0, c = 0;
+
+    for (int i = 0; i < n; i++) {
+        t = (dlimb_t)a[i] - b[i] - borrow;
+        r[i] = (limb_t)t;
+        borrow = (limb_t)(t >> LIMB_BITS) & 1;
+    }
+
+    // 음수이면 2의 보수: r = (r ^ mask) + 1
+    mask = 0 - borrow;
+    c = borrow;
+    for (int i = 0; i < n; i++) {
+        t = (dlimb_t)(r[i] ^ mask) + c;
+        r[i] = (limb_t)t;
+        c = (limb_t)(t >> LIMB_BITS);
+    }
+
+    return mask;
+}
+
+/*  r[0..2n) 에 z0, z2 가 들어있을 때 z1 = z0 + z2 + (m ^ neg) + (neg & 1) 을 B = 2^{h limb} 자리에 더함
+    neg = 전부 1 이면 z1 = z0 + z2 - m, 0 이면 z0 + z2 + m  */
+static void kara_merge(limb_t* r, const limb_t* m, limb_t neg, int n)
+{
+    limb_t z1[NUMLIMB + 1];
+    dlimb_t t = 0;
+    limb_t c = 0;
+    int h = n / 2;
+
+    for (int i = 0; i < n; i++) {
+        t = (dlimb_t)r[i] + r[n + i] + c;
+        z1[i] = (limb_t)t;
+        c = (limb_t)(t >> LIMB_BITS);
+    }
+    z1[n] = c;
+
+    c = neg & 1;
+    for (int i = 0; i < n; i++) {
+        t = (dlimb_t)z1[i] + (m[i] ^ neg) + c;
+        z1[i] = (limb_t)t;
+        c = (limb_t)(t >> LIMB_BITS);
+    }
+    z1[n] += neg + c;       // z1 >= 0 이고 n limb + 1비트 이하
+
+    c = 0;
+    for (int i = 0; i <= n; i++) {
+        t = (dlimb_t)r[h + i] + z1[i] + c;
+        r[h + i] = (limb_t)t;
+        c = (limb_t)(t >> LIMB_BITS);
+    }
+    for (int i = h + n + 1; i < 2*n; i++) {
+        t = (dlimb_t)r[i] + c;
+        r[i] = (limb_t)t;
+        c = (limb_t)(t >> LIMB_BITS);
+    }
+}
+
+static void kara_mul(limb_t* r, const limb_t* a, const limb_t* b, int n, int level)
+{
+    limb_t da[NUMLIMB / 2], db[NUMLIMB / 2], m[NUMLIMB];
+    limb_t sa = 0, sb = 0;
+    int h = n / 2;
+
+    if (level == 0 || n == 1) {
+        mul_school(r, a, b, n);
+        return;
+    }
+
+    kara_mul(r, a, b, h, level - 1);                // z0
+    kara_mul(r + n, a + h, b + h, h, level - 1);    // z2
+
+    sa = sub_abs(da, a, a + h, h);
+    sb = sub_abs(db, b, b + h, h);
+    kara_mul(m, da, db, h, level - 1);              // |a0 - a1| |b0 - b1|
+
+    // (a0 - a1)(b0 - b1) 의 부호가 양수 (sa == sb) 이면 빼고, 음수이면 더함
+    kara_merge(r, m, ~(sa ^ sb), n);
+}
+
+static void kara_sqr(limb_t* r, const limb_t* a, int n, int level)
+{
+    limb_t da[NUMLIMB / 2], m[NUMLIMB];
+    int h = n / 2;
+
+    if (level == 0 || n == 1) {
+        sqr_school(r, a, n);
+        return;
+    }
+
+    kara_sqr(r, a, h, level - 1);
+    kara_sqr(r + n, a + h, h, level - 1);
+
+    sub_abs(da, a, a + h, h);
+    kara_sqr(m, da, h, level - 1);                  // (a0 - a1)^2, 항상 뺌
+
+    kara_merge(r, m, (limb_t)-1, n);
+}
+
+/*  R = A * B, one-level / two-level Karatsuba  */
+void umul_kara1(BN2* ret, const BN* opa, const BN* opb)
+{
+    kara_mul(LIMBS(ret), LIMBS(opa), LIMBS(opb), NUMLIMB, 1);
+}
+
+void umul_kara2(BN2* ret, const BN* opa, const BN* opb)
+{
+    kara_mul(LIMBS(ret), LIMBS(opa), LIMBS(opb), NUMLIMB, 2);
+}
+
+/*  R = A^2, one-level / two-level Karatsuba  */
+void usqr_kara1(BN2* ret, const BN* opa)
+{
+    kara_sqr(LIMBS(ret), LIMBS(opa), NUMLIMB, 1);
+}
+
+void usqr_kara2(BN2* ret, const BN* opa)
+{
+    kara_sqr(LIMBS(ret), LIMBS(opa), NUMLIMB, 2);
 }
 
 /*  ret = opa mod p , p는 고정이므로 opa의 상위 256비트는 사전계산이 가능하다. 
-    사전계산을 잘 정리해서 만든 테이블이 s이다.  
+    사전계산을 잘 정리해서 만든 테이블이 s이다.  (s의 원소는 32비트 단위지만 덧셈/뺄셈은 uadd/usub을 따라 ECC_LIMB64에서 64비트로 동작)
     슈도코드에 맞게 더하거나 뺀 후, 마지막에 캐리 된 만큼 모듈링해준다. 이 때, 반복적으로 p를 빼거나 더하지 말고,
-    2p, 3p, 4p, 5p 테이블을 만든 후, 한번에 계산해주면, 연산속도를 높일 수 있다. */
+    2p, 3p, 4p, 5p 테이블을 만든 후, 한번에 계산해주면, 연산속도를 높일 수 있다.
+    
+    모듈링은 분기 없이 한다: c = c_add - c_sub 에 대해 |c|p를 테이블에서 마스크로 골라 더하거나 빼고,
+    남은 ret + h*2^256 (h = -1, 0, 1)을 p 한번 더하기/빼기 중에서 마스크로 고른다. 결과는 항상 [0, p). */
 void mod_fast(BN* ret, const BN2* opa)
 {
     uint32_t c_add = 0, c_sub = 0;
+    int32_t c = 0;
+    uint32_t m = 0, neg = 0, pos = 0, mask = 0, carry = 0, borrow = 0;
+    uint32_t m_add = 0, m_sub = 0;
+    BN kp = {0, }, r_add = {0, }, r_sub = {0, };
 
     // 상위 256비트 사전계산 테이블
     BN s[9] = {
@@ -258,9 +669,33 @@ void mod_fast(BN* ret, const BN2* opa)
     c_sub += usub(ret, ret, &s[7]);
     c_sub += usub(ret, ret, &s[8]);
 
-    // 모듈링
-    if (c_add > c_sub) usub(ret, ret, &nistp256[c_add - c_sub - 1]);
-    if (c_add < c_sub) uadd(ret, ret, &nistp256[c_sub - c_add - 1]);
+    // 모듈링: 값은 ret + c*2^256, c in [-4, 5]
+    c = (int32_t)(c_add - c_sub);
+    neg = (uint32_t)(c >> 31);                          // c < 0 이면 0xffffffff
+    pos = (uint32_t)(-c >> 31);                         // c > 0 이면 0xffffffff
+    m = ((uint32_t)c ^ neg) - neg;                      // m = |c|
+
+    // kp <-- |c|p mod 2^256, 테이블 전체를 읽어서 마스크로 고름 (c = 0 이면 kp = 0)
+    for (uint32_t k = 0; k < 5; k++) {
+        mask = 0 - (((m ^ (k + 1)) - 1) >> 31);
+        cset_bn(&kp, &nistp256[k], mask);
+    }
+
+    // |c|p = kp + (|c|-1)*2^256 이므로,
+    // c > 0: ret - kp 의 h = 1 - borrow, c < 0: ret + kp 의 h = carry - 1
+    borrow = usub(&r_sub, ret, &kp);
+    carry = uadd(&r_add, ret, &kp);
+    cset_bn(ret, &r_sub, pos);
+    cset_bn(ret, &r_add, neg);
+    m_add = neg & (carry - 1);                          // h = -1 --> p를 더함
+    m_sub = pos & (borrow - 1);                         // h = +1 --> p를 뺌
+
+    // h = 0 이면 ret >= p 일 때만 p를 뺌
+    borrow = usub(&r_sub, ret, &P);
+    m_sub |= ~(m_add | m_sub) & (borrow - 1);
+    uadd(&r_add, ret, &P);
+    cset_bn(ret, &r_sub, m_sub);
+    cset_bn(ret, &r_add, m_add);
 }
 
 /*  EEA의 binary 버전: u와 v를 줄여가며 1 = ax + py 를 만들어가는 것이 목표.
@@ -318,8 +753,11 @@ void inv(BN* ret, const BN* opa)
     else set_bn(ret, &x2);
 }
 
+/*  -DECC_MONT_GENERIC 이면 umul_ps 기반의 mont를, 기본은 word 단위 mont_word를 쓴다. (쓰지 않는 쪽은 컴파일하지 않음) */
+#ifdef ECC_MONT_GENERIC
 /*  multiplication in montgomery domain: a x b = (a*b)*R^{-1} mod p
-    이 곱셈은 나눗셈이 존재하지 않아 연산속도가 빠르다. 구현방법은 코드의 주석을 참고한다.  */
+    이 곱셈은 나눗셈이 존재하지 않아 연산속도가 빠르다. 구현방법은 코드의 주석을 참고한다.
+    umul_ps, uadd, addp 위에 만들어져 있으므로 ECC_LIMB64 에서는 그대로 64비트 limb로 동작한다.  */
 static void mont(BN* ret, const BN2* opa)
 {
     BN2 tmp = {0, };
@@ -327,17 +765,17 @@ static void mont(BN* ret, const BN2* opa)
     BN U_upper = {0, }, U_under = {0, };
 
     // T_under || T_upper <-- opa * opb
-    memcpy(T_under.v, opa->v, sizeof(BN));
-    memcpy(T_upper.v, &opa->v[NUMWORD], sizeof(BN));
+    memcpy(T_under.v, opa->v, sizeof(T_under.v));
+    memcpy(T_upper.v, &opa->v[NUMWORD], sizeof(T_upper.v));
 
     // U <-- T * p' mod R , m' = -p^{-1} --- p는 고정값이므로 사전계산 가능.
     umul_ps(&tmp, &T_under, &P_prime);
-    memcpy(&U_under, &tmp, sizeof(BN));
+    memcpy(U_under.v, tmp.v, sizeof(U_under.v));
     
     // U_upper || U_under <-- U * p
     umul_ps(&tmp, &U_under, &P);
-    memcpy(U_under.v, tmp.v, sizeof(BN));
-    memcpy(U_upper.v, &tmp.v[NUMWORD], sizeof(BN));
+    memcpy(U_under.v, tmp.v, sizeof(U_under.v));
+    memcpy(U_upper.v, &tmp.v[NUMWORD], sizeof(U_upper.v));
 
     // T <-- T + U * p, 이 때 하위 256비트는 무조건 0으로 차고, 버려짐.
     addp(ret, &T_upper, &U_upper);
@@ -345,6 +783,317 @@ static void mont(BN* ret, const BN2* opa)
         addp(ret, ret, &one);
     }
 }
+#define mont_redc mont
+#else
+/*  word 단위 montgomery reduction (P-256 전용)
+    p' = -p^{-1} mod 2^32 = 1 이므로 각 워드의 m = T[i] 이고, 곱셈 없이 T에 m * p * 2^{32i} 를 더하면 된다.
+    p = 2^256 - 2^224 + 2^192 + 2^96 - 1 이므로 m * p 는 시프트와 덧셈/뺄셈 뿐이다.
+        T[i] -= m, T[i+3] += m, T[i+6] += m, T[i+7] -= m, T[i+8] += m    (T[i]는 0이 됨)
+    워드마다 캐리를 끝까지 전파하지 않고 부호 있는 acc에 모아뒀다가, 다음 워드를 읽을 때 한칸씩만 넘긴다.
+    결과 (T + Mp) / R < 2p 이므로 마지막에 p를 한번 (마스크로) 뺀다.  */
+static void mont_word(BN* ret, const BN2* opa)
+{
+    BN r = {0, }, r_sub = {0, };
+    uint32_t top = 0, borrow = 0;
+
+#ifdef ECC_LIMB64
+    // 64비트 limb: p = (2^64 - 2^32 + 1) || 0 || (2^32 - 1) || (2^64 - 1), p' = 1 mod 2^64
+    __int128 acc[NUMDWORD2 + 1] = {0, };
+    uint64_t m = 0;
+
+    for (int i = 0; i < NUMDWORD2; i++) acc[i] = opa->d[i];
+
+    for (int i = 0; i < NUMDWORD; i++) {
+        // 아래 워드에서 넘어온 캐리 정리, m = T[i] mod 2^64
+        m = (uint64_t)acc[i];
+        acc[i + 1] += (acc[i] - m) >> 64;
+
+        // T += m * p * 2^{64i}
+        acc[i + 1] += (__int128)(m << 32);      // + m * 2^96
+        acc[i + 2] += (__int128)(m >> 32);
+        acc[i + 3] += (__int128)m;              // + m * 2^192
+        acc[i + 3] -= (__int128)(m << 32);      // - m * 2^224
+        acc[i + 4] -= (__int128)(m >> 32);
+        acc[i + 4] += (__int128)m;              // + m * 2^256
+    }
+
+    for (int i = NUMDWORD; i < NUMDWORD2; i++) {
+        r.d[i - NUMDWORD] = (uint64_t)acc[i];
+        acc[i + 1] += (acc[i] - (uint64_t)acc[i]) >> 64;
+    }
+    top = (uint32_t)acc[NUMDWORD2];
+#else
+    int64_t acc[NUMWORD2 + 1] = {0, };
+    uint32_t m = 0;
+
+    for (int i = 0; i < NUMWORD2; i++) acc[i] = opa->v[i];
+
+    for (int i = 0; i < NUMWORD; i++) {
+        // 아래 워드에서 넘어온 캐리 정리, m = T[i] mod 2^32
+        m = (uint32_t)acc[i];
+        acc[i + 1] += (acc[i] - m) >> 32;
+
+        // T += m * p * 2^{32i}
+        acc[i + 3] += m;
+        acc[i + 6] += m;
+        acc[i + 7] -= m;
+        acc[i + 8] += m;
+    }
+
+    for (int i = NUMWORD; i < NUMWORD2; i++) {
+        r.v[i - NUMWORD] = (uint32_t)acc[i];
+        acc[i + 1] += (acc[i] - (uint32_t)acc[i]) >> 32;
+    }
+    top = (uint32_t)acc[NUMWORD2];
+#endif
+
+    // top || r 이 p 이상이면 p를 뺌
+    borrow = usub(&r_sub, &r, &P);
+    cset_bn(&r, &r_sub, 0 - (top | (borrow ^ 1)));
+    set_bn(ret, &r);
+}
+#define mont_redc mont_word
+#endif
+
+/*______________________________________________________________
+    x86-64 BMI2/ADX montgomery 곱셈 (64비트 limb 4개)
+    mulx 는 플래그를 건드리지 않고, adcx (CF) / adox (OF) 는 서로 다른 캐리 체인을 쓰므로
+    곱의 하위/상위 워드를 두 체인으로 동시에 더할 수 있다.
+    CPU가 BMI2와 ADX를 지원하는지는 실행 중에 한번 확인하고, 아니면 umul_ps + mont_redc 로 계산한다.
+    -DECC_NO_ASM 이나 -DECC_MONT_GENERIC 이면 쓰지 않는다.
+________________________________________________________________*/
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(ECC_NO_ASM) && !defined(ECC_MONT_GENERIC)
+#define ECC_ADX
+#include <cpuid.h>
+
+static const uint64_t p64[NUMDWORD] = {0xffffffffffffffffULL, 0x00000000ffffffffULL, 0, 0xffffffff00000001ULL};
+static const uint64_t zero64 = 0;
+
+static int has_adx(void)
+{
+    static int adx = -1;
+    unsigned int a = 0, b = 0, c = 0, d = 0;
+
+    if (adx < 0) {
+        adx = __get_cpuid_count(7, 0, &a, &b, &c, &d) && (b & bit_BMI2) && (b & bit_ADX);
+    }
+
+    return adx;
+}
+
+/* t = a * b (512비트): b의 워드마다 a 한줄을 곱해서 adcx 로 하위 워드, adox 로 상위 워드를 더함 */
+static inline void umul_adx(uint64_t t[NUMDWORD2], const uint64_t* a, const uint64_t* b)
+{
+    uint64_t t0, t1, t2, t3, t4, t5, t6, t7, lo, hi;
+
+    __asm__ (
+        // b[0] 줄: t가 비어 있으므로 add/adc 한 체인이면 됨
+        "movq   0(%[b]), %%rdx\n\t"
+        "mulxq  0(%[a]), %[t0], %[t1]\n\t"
+        "mulxq  8(%[a]), %[lo], %[t2]\n\t"
+        "addq   %[lo], %[t1]\n\t"
+        "mulxq  16(%[a]), %[lo], %[t3]\n\t"
+        "adcq   %[lo], %[t2]\n\t"
+        "mulxq  24(%[a]), %[lo], %[t4]\n\t"
+        "adcq   %[lo], %[t3]\n\t"
+        "adcq   $0, %[t4]\n\t"
+
+        // b[1] 줄
+        "movq   8(%[b]), %%rdx\n\t"
+        "xorl   %k[hi], %k[hi]\n\t"
+        "mulxq  0(%[a]), %[lo], %[hi]\n\t"
+        "adcxq  %[lo], %[t1]\n\t"
+        "adoxq  %[hi], %[t2]\n\t"
+        "mulxq  8(%[a]), %[lo], %[hi]\n\t"
+        "adcxq  %[lo], %[t2]\n\t"
+        "adoxq  %[hi], %[t3]\n\t"
+        "mulxq  16(%[a]), %[lo], %[hi]\n\t"
+        "adcxq  %[lo], %[t3]\n\t"
+        "adoxq  %[hi], %[t4]\n\t"
+        "mulxq  24(%[a]), %[lo], %[t5]\n\t"
+        "adcxq  %[lo], %[t4]\n\t"
+        "adcxq  %[z], %[t5]\n\t"
+        "adoxq  %[z], %[t5]\n\t"
+
+        // b[2] 줄
+        "movq   16(%[b]), %%rdx\n\t"
+        "xorl   %k[hi], %k[hi]\n\t"
+        "mulxq  0(%[a]), %[lo], %[hi]\n\t"
+        "adcxq  %[lo], %[t2]\n\t"
+        "adoxq  %[hi], %[t3]\n\t"
+        "mulxq  8(%[a]), %[lo], %[hi]\n\t"
+        "adcxq  %[lo], %[t3]\n\t"
+        "adoxq  %[hi], %[t4]\n\t"
+        "mulxq  16(%[a]), %[lo], %[hi]\n\t"
+        "adcxq  %[lo], %[t4]\n\t"
+        "adoxq  %[hi], %[t5]\n\t"
+        "mulxq  24(%[a]), %[lo], %[t6]\n\t"
+        "adcxq  %[lo], %[t5]\n\t"
+        "adcxq  %[z], %[t6]\n\t"
+        "adoxq  %[z], %[t6]\n\t"
+
+        // b[3] 줄
+        "movq   24(%[b]), %%rdx\n\t"
+        "xorl   %k[hi], %k[hi]\n\t"
+        "mulxq  0(%[a]), %[lo], %[hi]\n\t"
+        "adcxq  %[lo], %[t3]\n\t"
+        "adoxq  %[hi], %[t4]\n\t"
+        "mulxq  8(%[a]), %[lo], %[hi]\n\t"
+        "adcxq  %[lo], %[t4]\n\t"
+        "adoxq  %[hi], %[t5]\n\t"
+        "mulxq  16(%[a]), %[lo], %[hi]\n\t"
+        "adcxq  %[lo], %[t5]\n\t"
+        "adoxq  %[hi], %[t6]\n\t"
+        "mulxq  24(%[a]), %[lo], %[t7]\n\t"
+        "adcxq  %[lo], %[t6]\n\t"
+        "adcxq  %[z], %[t7]\n\t"
+        "adoxq  %[z], %[t7]\n\t"
+        : [t0] "=&r" (t0), [t1] "=&r" (t1), [t2] "=&r" (t2), [t3] "=&r" (t3),
+          [t4] "=&r" (t4), [t5] "=&r" (t5), [t6] "=&r" (t6), [t7] "=&r" (t7),
+          [lo] "=&r" (lo), [hi] "=&r" (hi)
+        : [a] "r" (a), [b] "r" (b), [z] "m" (zero64)
+        : "rdx", "cc", "memory");
+
+    t[0] = t0; t[1] = t1; t[2] = t2; t[3] = t3;
+    t[4] = t4; t[5] = t5; t[6] = t6; t[7] = t7;
+}
+
+/*  t = a^2 (512비트): a_i * a_j (i < j) 를 한번씩 곱해서 2배 한 후 대각선 a_i^2 를 더함  */
+static inline void usqr_adx(uint64_t t[NUMDWORD2], const uint64_t* a)
+{
+    uint64_t t0, t1, t2, t3, t4, t5, t6, t7, lo, hi;
+
+    __asm__ (
+        // a[0] * a[1..3]
+        "movq   0(%[a]), %%rdx\n\t"
+        "mulxq  8(%[a]), %[t1], %[t2]\n\t"
+        "mulxq  16(%[a]), %[lo], %[t3]\n\t"
+        "addq   %[lo], %[t2]\n\t"
+        "mulxq  24(%[a]), %[lo], %[t4]\n\t"
+        "adcq   %[lo], %[t3]\n\t"
+        "adcq   $0, %[t4]\n\t"
+
+        // a[1] * a[2..3]
+        "movq   8(%[a]), %%rdx\n\t"
+        "xorl   %k[hi], %k[hi]\n\t"
+        "mulxq  16(%[a]), %[lo], %[hi]\n\t"
+        "adcxq  %[lo], %[t3]\n\t"
+        "adoxq  %[hi], %[t4]\n\t"
+        "mulxq  24(%[a]), %[lo], %[t5]\n\t"
+        "adcxq  %[lo], %[t4]\n\t"
+        "adcxq  %[z], %[t5]\n\t"
+        "adoxq  %[z], %[t5]\n\t"
+
+        // a[2] * a[3]
+        "movq   16(%[a]), %%rdx\n\t"
+        "mulxq  24(%[a]), %[lo], %[t6]\n\t"
+        "addq   %[lo], %[t5]\n\t"
+        "adcq   $0, %[t6]\n\t"
+
+        // 2배: t7 은 최상위 비트
+        "xorl   %k[t7], %k[t7]\n\t"
+        "addq   %[t1], %[t1]\n\t"
+        "adcq   %[t2], %[t2]\n\t"
+        "adcq   %[t3], %[t3]\n\t"
+        "adcq   %[t4], %[t4]\n\t"
+        "adcq   %[t5], %[t5]\n\t"
+        "adcq   %[t6], %[t6]\n\t"
+        "adcq   $0, %[t7]\n\t"
+
+        // 대각선 a_i^2 를 adox 한 체인으로 더함 (mulx는 플래그를 건드리지 않음)
+        "movq   0(%[a]), %%rdx\n\t"
+        "mulxq  %%rdx, %[t0], %[hi]\n\t"
+        "xorl   %k[lo], %k[lo]\n\t"
+        "adoxq  %[hi], %[t1]\n\t"
+        "movq   8(%[a]), %%rdx\n\t"
+        "mulxq  %%rdx, %[lo], %[hi]\n\t"
+        "adoxq  %[lo], %[t2]\n\t"
+        "adoxq  %[hi], %[t3]\n\t"
+        "movq   16(%[a]), %%rdx\n\t"
+        "mulxq  %%rdx, %[lo], %[hi]\n\t"
+        "adoxq  %[lo], %[t4]\n\t"
+        "adoxq  %[hi], %[t5]\n\t"
+        "movq   24(%[a]), %%rdx\n\t"
+        "mulxq  %%rdx, %[lo], %[hi]\n\t"
+        "adoxq  %[lo], %[t6]\n\t"
+        "adoxq  %[hi], %[t7]\n\t"
+        : [t0] "=&r" (t0), [t1] "=&r" (t1), [t2] "=&r" (t2), [t3] "=&r" (t3),
+          [t4] "=&r" (t4), [t5] "=&r" (t5), [t6] "=&r" (t6), [t7] "=&r" (t7),
+          [lo] "=&r" (lo), [hi] "=&r" (hi)
+        : [a] "r" (a), [z] "m" (zero64)
+        : "rdx", "cc", "memory");
+
+    t[0] = t0; t[1] = t1; t[2] = t2; t[3] = t3;
+    t[4] = t4; t[5] = t5; t[6] = t6; t[7] = t7;
+}
+
+/*  montgomery reduction: ret = t * 2^{-256} mod p
+    p' = 1 mod 2^64 이므로 m = u0, 그리고 u0 + m * p0 = m * 2^64 (p0 = 2^64 - 1) 이라서 u1 에 m 을 더하면 된다.
+    p2 = 0 이므로 한 워드에 곱셈은 m * p1, m * p3 두번뿐이다.
+    하위 256비트 t_lo 만 4번 줄이면 (t_lo + Mp) / R <= p 이고, 여기에 t_hi 를 더한 후 p 를 한번 뺀다. (mont_word 와 같은 범위) */
+static inline void redc_adx(BN* ret, const uint64_t t[NUMDWORD2])
+{
+    uint64_t u0 = t[0], u1 = t[1], u2 = t[2], u3 = t[3], u4 = 0;
+    uint64_t h0 = t[4], h1 = t[5], h2 = t[6], h3 = t[7];
+    uint64_t lo, hi;
+
+#define REDC_ADX_ROUND(a0, a1, a2, a3, a4)          \
+        "movq   %[" a0 "], %%rdx\n\t"               \
+        "xorl   %k[hi], %k[hi]\n\t"                 \
+        "mulxq  %[p1], %[lo], %[hi]\n\t"            \
+        "adcxq  %%rdx, %[" a1 "]\n\t"               \
+        "adoxq  %[lo], %[" a1 "]\n\t"               \
+        "adcxq  %[hi], %[" a2 "]\n\t"               \
+        "mulxq  %[p3], %[lo], %[hi]\n\t"            \
+        "adoxq  %[z], %[" a2 "]\n\t"                \
+        "adcxq  %[lo], %[" a3 "]\n\t"               \
+        "adoxq  %[z], %[" a3 "]\n\t"                \
+        "adcxq  %[hi], %[" a4 "]\n\t"               \
+        "adoxq  %[z], %[" a4 "]\n\t"                \
+        "movq   $0, %[" a0 "]\n\t"                  \
+        "adcxq  %[z], %[" a0 "]\n\t"                \
+        "adoxq  %[z], %[" a0 "]\n\t"
+
+    __asm__ (
+        // 한 라운드마다 워드 하나가 0이 되고 그 자리는 다음 최상위 워드로 재사용
+        REDC_ADX_ROUND("u0", "u1", "u2", "u3", "u4")
+        REDC_ADX_ROUND("u1", "u2", "u3", "u4", "u0")
+        REDC_ADX_ROUND("u2", "u3", "u4", "u0", "u1")
+        REDC_ADX_ROUND("u3", "u4", "u0", "u1", "u2")
+
+        // (u4, u0, u1, u2) + t_hi, 캐리는 u3
+        "addq   %[h0], %[u4]\n\t"
+        "adcq   %[h1], %[u0]\n\t"
+        "adcq   %[h2], %[u1]\n\t"
+        "adcq   %[h3], %[u2]\n\t"
+        "movq   $0, %[u3]\n\t"
+        "adcq   $0, %[u3]\n\t"
+
+        // u3 || u - p 가 음수가 아니면 그 값을 씀
+        "movq   %[u4], %[h0]\n\t"
+        "movq   %[u0], %[h1]\n\t"
+        "movq   %[u1], %[h2]\n\t"
+        "movq   %[u2], %[h3]\n\t"
+        "subq   0+%[p], %[h0]\n\t"
+        "sbbq   8+%[p], %[h1]\n\t"
+        "sbbq   $0, %[h2]\n\t"
+        "sbbq   24+%[p], %[h3]\n\t"
+        "sbbq   $0, %[u3]\n\t"
+        "cmovncq %[h0], %[u4]\n\t"
+        "cmovncq %[h1], %[u0]\n\t"
+        "cmovncq %[h2], %[u1]\n\t"
+        "cmovncq %[h3], %[u2]\n\t"
+        : [u0] "+&r" (u0), [u1] "+&r" (u1), [u2] "+&r" (u2), [u3] "+&r" (u3), [u4] "+&r" (u4),
+          [h0] "+&r" (h0), [h1] "+&r" (h1), [h2] "+&r" (h2), [h3] "+&r" (h3),
+          [lo] "=&r" (lo), [hi] "=&r" (hi)
+        : [p1] "m" (p64[1]), [p3] "m" (p64[3]), [p] "m" (p64), [z] "m" (zero64)
+        : "rdx", "cc");
+#undef REDC_ADX_ROUND
+
+    ret->d[0] = u4; ret->d[1] = u0; ret->d[2] = u1; ret->d[3] = u2;
+    ret->s = 0;
+}
+#endif
 
 /*  a x b = (ab)R^{-1} mod p
     (a x b) x R^{2} = ((ab)R^{-1}R^2)R^{-1} = ab mod p
@@ -355,9 +1104,9 @@ void mulp(BN *ret, const BN* opa, const BN* opb)
     BN2 T = {0, };
 
     umul_ps(&T, opa, opb);
-    mont(ret, &T);
+    mont_redc(ret, &T);
     umul_ps(&T, ret, &RRmodP);
-    mont(ret, &T);
+    mont_redc(ret, &T);
 }
 
 /*  montgomery sqr version  */
@@ -366,9 +1115,549 @@ void sqrp(BN *ret, const BN* opa)
     BN2 T = {0, };
 
     usqr_ps(&T, opa);
-    mont(ret, &T);
+    mont_redc(ret, &T);
     umul_ps(&T, ret, &RRmodP);
-    mont(ret, &T);
+    mont_redc(ret, &T);
+}
+
+/*  solinas (special form) 곱셈: 곱한 후 mod_fast로 감산. domain 변환이 필요 없다. */
+void mulp_solinas(BN* ret, const BN* opa, const BN* opb)
+{
+    BN2 T = {0, };
+
+    umul_ps(&T, opa, opb);
+    mod_fast(ret, &T);
+}
+
+/*  solinas sqr version  */
+void sqrp_solinas(BN* ret, const BN* opa)
+{
+    BN2 T = {0, };
+
+    usqr_ps(&T, opa);
+    mod_fast(ret, &T);
+}
+
+/*  montgomery domain 변환: a --> aR mod p
+    a x R^2 = (a*R^2)R^{-1} = aR mod p 이므로 한번의 몽고메리 곱셈이면 된다. */
+void to_mont(BN_MONT* ret, const BN* opa)
+{
+    BN2 T = {0, };
+
+#ifdef ECC_ADX
+    if (has_adx()) {
+        umul_adx(T.d, opa->d, RRmodP.d);
+        redc_adx(ret, T.d);
+        return;
+    }
+#endif
+    umul_ps(&T, opa, &RRmodP);
+    mont_redc(ret, &T);
+}
+
+/*  montgomery domain 역변환: aR --> a mod p
+    상위 256비트가 0인 T = aR 에 대해 mont를 한번 하면 (aR)R^{-1} = a 이다. */
+void from_mont(BN* ret, const BN_MONT* opa)
+{
+    BN2 T = {0, };
+
+    memcpy(T.v, opa->v, sizeof(opa->v));
+    mont_redc(ret, &T);
+}
+
+/*  montgomery domain 안에서의 곱셈: aR x bR = (aR*bR)R^{-1} = abR mod p
+    점연산은 전부 domain 안에서 이루어지므로 mulp와 달리 RRmodP 곱셈이 필요 없다. */
+void mulp_mont(BN_MONT* ret, const BN_MONT* opa, const BN_MONT* opb)
+{
+    BN2 T = {0, };
+
+#ifdef ECC_ADX
+    if (has_adx()) {
+        umul_adx(T.d, opa->d, opb->d);
+        redc_adx(ret, T.d);
+        return;
+    }
+#endif
+    umul_ps(&T, opa, opb);
+    mont_redc(ret, &T);
+}
+
+/*  montgomery domain sqr version  */
+void sqrp_mont(BN_MONT* ret, const BN_MONT* opa)
+{
+    BN2 T = {0, };
+
+#ifdef ECC_ADX
+    if (has_adx()) {
+        usqr_adx(T.d, opa->d);
+        redc_adx(ret, T.d);
+        return;
+    }
+#endif
+    usqr_ps(&T, opa);
+    mont_redc(ret, &T);
+}
+
+/*  lazy reduction: 두 곱 ab, cd 를 BN2 에서 바로 더하거나 뺀 후 montgomery reduction은 한번만 한다.
+    mont_redc 는 T < pR 이면 결과가 p 미만이므로, 합/차를 상위 256비트에 p 를 더하거나 빼서 [0, pR) 로 맞춘다.
+        ab + cd in [0, 2p^2) : pR 이상이면 pR 을 뺌 (513비트가 될 수 있으므로 캐리도 같이 봄)
+        ab - cd in (-p^2, p^2) : 음수이면 pR 을 더함
+    곱셈 두번에 reduction 한번, addp/subp 는 없음.  */
+static void umul_wide(BN2* ret, const BN* opa, const BN* opb)
+{
+#ifdef ECC_ADX
+    if (has_adx()) {
+        umul_adx(ret->d, opa->d, opb->d);
+        return;
+    }
+#endif
+    umul_ps(ret, opa, opb);
+}
+
+static void redc_wide(BN* ret, const BN2* opa)
+{
+#ifdef ECC_ADX
+    if (has_adx()) {
+        redc_adx(ret, opa->d);
+        return;
+    }
+#endif
+    mont_redc(ret, opa);
+}
+
+/*  T = T + U 또는 T - U (512비트) 후 상위 256비트에 p 를 조건부로 더하거나 빼서 [0, pR) 로 맞춤
+    sub = 0 : T + U, carry || T >= pR 이면 pR 을 뺌
+    sub = 1 : T - U, 빌림이 있으면 pR 을 더함 (2^512 을 넘는 캐리는 빌림과 상쇄)  */
+static void addsub_wide(BN2* T, const BN2* U, int sub)
+{
+    limb_t hi[NUMLIMB], mask = 0;
+    dlimb_t t = 0;
+    uint32_t c = 0, borrow = 0;
+
+    if (sub) {
+        for (int i = 0; i < 2*NUMLIMB; i++) {
+            t = (dlimb_t)LIMBS(T)[i] - LIMBS(U)[i] - c;
+            LIMBS(T)[i] = (limb_t)t;
+            c = (uint32_t)(t >> LIMB_BITS) & 1;
+        }
+        mask = 0 - (limb_t)c;
+        c = 0;
+        for (int i = 0; i < NUMLIMB; i++) {
+            t = (dlimb_t)LIMBS(T)[NUMLIMB + i] + (LIMBS(&P)[i] & mask) + c;
+            LIMBS(T)[NUMLIMB + i] = (limb_t)t;
+            c = (uint32_t)(t >> LIMB_BITS);
+        }
+    } else {
+        for (int i = 0; i < 2*NUMLIMB; i++) {
+            t = (dlimb_t)LIMBS(T)[i] + LIMBS(U)[i] + c;
+            LIMBS(T)[i] = (limb_t)t;
+            c = (uint32_t)(t >> LIMB_BITS);
+        }
+        for (int i = 0; i < NUMLIMB; i++) {
+            t = (dlimb_t)LIMBS(T)[NUMLIMB + i] - LIMBS(&P)[i] - borrow;
+            hi[i] = (limb_t)t;
+            borrow = (uint32_t)(t >> LIMB_BITS) & 1;
+        }
+        mask = 0 - (limb_t)(c | (borrow ^ 1));
+        for (int i = 0; i < NUMLIMB; i++) {
+            LIMBS(T)[NUMLIMB + i] ^= (LIMBS(T)[NUMLIMB + i] ^ hi[i]) & mask;
+        }
+    }
+}
+
+/*  ret = a x b + c x d  (montgomery domain)  */
+void mulp_add_mul_mont(BN_MONT* ret, const BN_MONT* opa, const BN_MONT* opb, const BN_MONT* opc, const BN_MONT* opd)
+{
+    BN2 T, U;
+
+    umul_wide(&T, opa, opb);
+    umul_wide(&U, opc, opd);
+    addsub_wide(&T, &U, 0);
+    redc_wide(ret, &T);
+}
+
+/*  ret = a x b - c x d  (montgomery domain)  */
+void mulp_sub_mul_mont(BN_MONT* ret, const BN_MONT* opa, const BN_MONT* opb, const BN_MONT* opc, const BN_MONT* opd)
+{
+    BN2 T, U;
+
+    umul_wide(&T, opa, opb);
+    umul_wide(&U, opc, opd);
+    addsub_wide(&T, &U, 1);
+    redc_wide(ret, &T);
+}
+
+/*  solinas 엔진은 reduction을 미룰 수 없으므로 곱셈 두번 후 더하거나 뺀다. */
+void mulp_add_mul_solinas(BN* ret, const BN* opa, const BN* opb, const BN* opc, const BN* opd)
+{
+    BN t1, t2;
+
+    mulp_solinas(&t1, opa, opb);
+    mulp_solinas(&t2, opc, opd);
+    addp(ret, &t1, &t2);
+}
+
+void mulp_sub_mul_solinas(BN* ret, const BN* opa, const BN* opb, const BN* opc, const BN* opd)
+{
+    BN t1, t2;
+
+    mulp_solinas(&t1, opa, opb);
+    mulp_solinas(&t2, opc, opd);
+    subp(ret, &t1, &t2);
+}
+
+/*  repeated squaring: ret = a^{2^n}, field engine domain 안에서 n번 제곱  */
+void sqrp_n(BN* ret, const BN* opa, int n)
+{
+    BN r = {0, };
+
+    set_bn(&r, opa);
+    for (int i = 0; i < n; i++) {
+        sqrp_fe(&r, &r);
+    }
+
+    set_bn(ret, &r);
+}
+
+/*  fermat inversion: a^{-1} = a^{p-2} mod p, field engine domain 안에서 계산한다.
+    p-2 = ffffffff 00000001 00000000 00000000 00000000 ffffffff ffffffff fffffffd
+    x_k = a^{2^k - 1} (1이 k개) 을 만들어가는 addition chain: 255-sqr + 12-mul
+    분기나 데이터에 따라 달라지는 반복이 없어서 항상 같은 시간이 걸린다. (a = 0 이면 0을 돌려줌) */
+void inv_fermat(BN* ret, const BN* opa)
+{
+    BN x2, x3, x6, x12, x15, x30, x32;
+    BN t;
+
+    sqrp_fe(&t, opa);
+    mulp_fe(&x2, &t, opa);          // 11
+    sqrp_fe(&t, &x2);
+    mulp_fe(&x3, &t, opa);          // 111
+    sqrp_n(&t, &x3, 3);
+    mulp_fe(&x6, &t, &x3);          // 111111
+    sqrp_n(&t, &x6, 6);
+    mulp_fe(&x12, &t, &x6);
+    sqrp_n(&t, &x12, 3);
+    mulp_fe(&x15, &t, &x3);
+    sqrp_n(&t, &x15, 15);
+    mulp_fe(&x30, &t, &x15);
+    sqrp_n(&t, &x30, 2);
+    mulp_fe(&x32, &t, &x2);         // ffffffff
+
+    sqrp_n(&t, &x32, 32);
+    mulp_fe(&t, &t, opa);           // ffffffff 00000001
+    sqrp_n(&t, &t, 128);
+    mulp_fe(&t, &t, &x32);          // ffffffff 00000001 00000000 00000000 00000000 ffffffff
+    sqrp_n(&t, &t, 32);
+    mulp_fe(&t, &t, &x32);          // ... ffffffff ffffffff
+    sqrp_n(&t, &t, 30);
+    mulp_fe(&t, &t, &x30);          // ... ffffffff ffffffff 3fffffff
+    sqrp_n(&t, &t, 2);
+    mulp_fe(ret, &t, opa);          // ... ffffffff ffffffff fffffffd
+}
+
+/*  Bernstein-Yang safegcd (divstep) inversion, libsecp256k1의 modinv32와 같은 구조.
+    f = m, g = a 에서 시작해서 divstep을 반복하면 g는 0이 되고 f = +-1, d = +-a^{-1} 이 된다.
+        delta > 0 이고 g가 홀수: (delta, f, g) <-- (1 - delta, g, (g - f)/2)
+        g가 홀수                : (delta, f, g) <-- (1 + delta, f, (g + f)/2)
+        g가 짝수                : (delta, f, g) <-- (1 + delta, f, g/2)
+    30번의 divstep은 f, g의 하위 30비트만 보고 정해지므로, 2x2 변환행렬 t로 모아서 한번에 적용한다.
+    256비트 입력은 590번이면 충분하므로 30 x 20 = 600번을 분기 없이 항상 돈다.
+    수는 30비트 limb 9개 (signed30, 각 limb는 부호 있음)로 표현한다. */
+typedef struct {
+    int32_t v[9];
+} BN_S30;
+
+typedef struct {
+    BN_S30 modulus;
+    uint32_t modulus_inv30;         // modulus^{-1} mod 2^30
+} MODINFO30;
+
+typedef struct {
+    int32_t u, v, q, r;
+} TRANS2X2;
+
+static const MODINFO30 modinfo_p = {
+    {{0x3fffffff, 0x3fffffff, 0x3fffffff, 0x0000003f, 0x00000000, 
+      0x00000000, 0x00001000, 0x3fffc000, 0x0000ffff}}, 0x3fffffff};
+
+static const MODINFO30 modinfo_n = {
+    {{0x3c632551, 0x0ee72b0b, 0x3179e84f, 0x39beab69, 0x3fffffbc, 
+      0x3fffffff, 0x00000fff, 0x3fffc000, 0x0000ffff}}, 0x11ff43b1};
+
+#define M30 ((int32_t)(UINT32_MAX >> 2))
+
+/* BN (32비트 워드 8개) <--> signed30 (30비트 limb 9개) */
+static void bn_to_s30(BN_S30* ret, const BN* opa)
+{
+    uint64_t acc = 0;
+    int bits = 0, j = 0;
+
+    for (int i = 0; i < NUMWORD; i++) {
+        acc |= (uint64_t)opa->v[i] << bits;
+        bits += 32;
+        while (bits >= 30) {
+            ret->v[j++] = (int32_t)(acc & M30);
+            acc >>= 30;
+            bits -= 30;
+        }
+    }
+    ret->v[j] = (int32_t)acc;
+}
+
+/* limb가 [0, 2^30) 로 정규화된 signed30 --> BN */
+static void s30_to_bn(BN* ret, const BN_S30* opa)
+{
+    uint64_t acc = 0;
+    int bits = 0, j = 0;
+
+    for (int i = 0; i < 9; i++) {
+        acc |= (uint64_t)opa->v[i] << bits;
+        bits += 30;
+        while (bits >= 32 && j < NUMWORD) {
+            ret->v[j++] = (uint32_t)acc;
+            acc >>= 32;
+            bits -= 32;
+        }
+    }
+}
+
+/*  30번의 divstep, zeta = -(delta + 1/2).
+    u, v, q, r 은 부호 있는 값이지만 왼쪽 시프트를 위해 unsigned로 다룬다.
+    t * [f0, g0] = [f, g] * 2^30 이 되는 t를 만든다. */
+static int32_t divsteps_30(int32_t zeta, uint32_t f0, uint32_t g0, TRANS2X2* t)
+{
+    uint32_t u = 1, v = 0, q = 0, r = 1;
+    uint32_t c1 = 0, c2 = 0, mask1 = 0, mask2 = 0;
+    uint32_t f = f0, g = g0, x = 0, y = 0, z = 0;
+
+    for (int i = 0; i < 30; i++) {
+        // mask1: zeta < 0 (delta > 0), mask2: g가 홀수
+        c1 = (uint32_t)(zeta >> 31);
+        mask1 = c1;
+        c2 = g & 1;
+        mask2 = 0 - c2;
+
+        // x, y, z = 조건부로 부호를 바꾼 f, u, v
+        x = (f ^ mask1) - mask1;
+        y = (u ^ mask1) - mask1;
+        z = (v ^ mask1) - mask1;
+
+        // g가 홀수이면 g, q, r 에 더함
+        g += x & mask2;
+        q += y & mask2;
+        r += z & mask2;
+
+        // delta > 0 이고 g가 홀수이면 swap: zeta <-- -zeta - 2, 아니면 zeta <-- zeta - 1
+        mask1 &= mask2;
+        zeta = (int32_t)(((uint32_t)zeta ^ mask1) - 1);
+        f += g & mask1;
+        u += q & mask1;
+        v += r & mask1;
+
+        // g <-- g/2, 대신 u, v를 2배
+        g >>= 1;
+        u <<= 1;
+        v <<= 1;
+    }
+
+    t->u = (int32_t)u;
+    t->v = (int32_t)v;
+    t->q = (int32_t)q;
+    t->r = (int32_t)r;
+
+    return zeta;
+}
+
+/*  [d, e] <-- t * [d, e] / 2^30 mod m
+    2^30으로 나누어떨어지도록 m의 배수 (md, me)를 더해준다. */
+static void update_de_30(BN_S30* d, BN_S30* e, const TRANS2X2* t, const MODINFO30* mod)
+{
+    const int32_t u = t->u, v = t->v, q = t->q, r = t->r;
+    int32_t di = 0, ei = 0, md = 0, me = 0, sd = 0, se = 0;
+    int64_t cd = 0, ce = 0;
+
+    // d, e가 음수이면 결과가 범위를 벗어나지 않도록 [u, q], [v, r] 만큼 m을 더 더함
+    sd = d->v[8] >> 31;
+    se = e->v[8] >> 31;
+    md = (u & sd) + (v & se);
+    me = (q & sd) + (r & se);
+
+    di = d->v[0];
+    ei = e->v[0];
+    cd = (int64_t)u * di + (int64_t)v * ei;
+    ce = (int64_t)q * di + (int64_t)r * ei;
+
+    // 하위 30비트가 0이 되도록 md, me 보정
+    md -= (int32_t)((mod->modulus_inv30 * (uint32_t)cd + (uint32_t)md) & M30);
+    me -= (int32_t)((mod->modulus_inv30 * (uint32_t)ce + (uint32_t)me) & M30);
+
+    cd += (int64_t)mod->modulus.v[0] * md;
+    ce += (int64_t)mod->modulus.v[0] * me;
+    cd >>= 30;
+    ce >>= 30;
+
+    for (int i = 1; i < 9; i++) {
+        di = d->v[i];
+        ei = e->v[i];
+        cd += (int64_t)u * di + (int64_t)v * ei;
+        ce += (int64_t)q * di + (int64_t)r * ei;
+        cd += (int64_t)mod->modulus.v[i] * md;
+        ce += (int64_t)mod->modulus.v[i] * me;
+        d->v[i - 1] = (int32_t)cd & M30; cd >>= 30;
+        e->v[i - 1] = (int32_t)ce & M30; ce >>= 30;
+    }
+    d->v[8] = (int32_t)cd;
+    e->v[8] = (int32_t)ce;
+}
+
+/*  [f, g] <-- t * [f, g] / 2^30, 하위 30비트는 항상 0이다. */
+static void update_fg_30(BN_S30* f, BN_S30* g, const TRANS2X2* t)
+{
+    const int32_t u = t->u, v = t->v, q = t->q, r = t->r;
+    int32_t fi = 0, gi = 0;
+    int64_t cf = 0, cg = 0;
+
+    fi = f->v[0];
+    gi = g->v[0];
+    cf = (int64_t)u * fi + (int64_t)v * gi;
+    cg = (int64_t)q * fi + (int64_t)r * gi;
+    cf >>= 30;
+    cg >>= 30;
+
+    for (int i = 1; i < 9; i++) {
+        fi = f->v[i];
+        gi = g->v[i];
+        cf += (int64_t)u * fi + (int64_t)v * gi;
+        cg += (int64_t)q * fi + (int64_t)r * gi;
+        f->v[i - 1] = (int32_t)cf & M30; cf >>= 30;
+        g->v[i - 1] = (int32_t)cg & M30; cg >>= 30;
+    }
+    f->v[8] = (int32_t)cf;
+    g->v[8] = (int32_t)cg;
+}
+
+/*  d in (-2m, m) --> [0, m), sign < 0 이면 부호도 바꿈. 분기 없이 마스크로. */
+static void normalize_30(BN_S30* d, int32_t sign, const MODINFO30* mod)
+{
+    int32_t cond_add = 0, cond_neg = 0;
+
+    // 음수이면 m을 더하고, 필요하면 부호를 바꿈: (-m, m)
+    cond_add = d->v[8] >> 31;
+    cond_neg = sign >> 31;
+    for (int i = 0; i < 9; i++) {
+        d->v[i] += mod->modulus.v[i] & cond_add;
+        d->v[i] = (d->v[i] ^ cond_neg) - cond_neg;
+    }
+    for (int i = 0; i < 8; i++) {
+        d->v[i + 1] += d->v[i] >> 30;
+        d->v[i] &= M30;
+    }
+
+    // 아직 음수이면 m을 한번 더: [0, m)
+    cond_add = d->v[8] >> 31;
+    for (int i = 0; i < 9; i++) {
+        d->v[i] += mod->modulus.v[i] & cond_add;
+    }
+    for (int i = 0; i < 8; i++) {
+        d->v[i + 1] += d->v[i] >> 30;
+        d->v[i] &= M30;
+    }
+}
+
+/*  ret = opa^{-1} mod m, opa in [0, m) */
+static void divstep_inv(BN* ret, const BN* opa, const MODINFO30* mod)
+{
+    BN_S30 d = {{0}};
+    BN_S30 e = {{1}};
+    BN_S30 f = mod->modulus;
+    BN_S30 g = {{0}};
+    TRANS2X2 t = {0, };
+    int32_t zeta = -1;              // delta = 1/2
+
+    bn_to_s30(&g, opa);
+
+    for (int i = 0; i < 20; i++) {
+        zeta = divsteps_30(zeta, (uint32_t)f.v[0], (uint32_t)g.v[0], &t);
+        update_de_30(&d, &e, &t, mod);
+        update_fg_30(&f, &g, &t);
+    }
+
+    // f = +-1 --> d = +-opa^{-1}
+    normalize_30(&d, f.v[8], mod);
+    s30_to_bn(ret, &d);
+}
+
+/*  ret = opa^{-1} mod p (divstep) */
+void inv_divstep(BN* ret, const BN* opa)
+{
+    divstep_inv(ret, opa, &modinfo_p);
+}
+
+/*  ret = opa^{-1} mod n (divstep), n = 군의 위수 */
+void inv_divstep_n(BN* ret, const BN* opa)
+{
+    divstep_inv(ret, opa, &modinfo_n);
+}
+
+/*  역원 backend 선택. 빌드할 때 고른다.
+    기본             : divstep (inv_divstep)
+    -DECC_INV_FERMAT : fermat (inv_fermat), field engine domain 안에서 계산
+    -DECC_INV_EEA    : binary EEA (inv)
+    invp는 일반 domain, inv_fe는 field engine domain의 원소를 받는다. */
+void invp(BN* ret, const BN* opa)
+{
+#if defined(ECC_INV_FERMAT)
+    BN t;
+
+    to_fe(&t, opa);
+    inv_fermat(&t, &t);
+    from_fe(ret, &t);
+#elif defined(ECC_INV_EEA)
+    inv(ret, opa);
+#else
+    inv_divstep(ret, opa);
+#endif
+}
+
+void inv_fe(BN* ret, const BN* opa)
+{
+#if defined(ECC_INV_FERMAT)
+    inv_fermat(ret, opa);
+#else
+    BN t;
+
+    from_fe(&t, opa);
+    invp(&t, &t);
+    to_fe(ret, &t);
+#endif
+}
+
+/*  batch inversion (montgomery's trick): out[i] = in[i]^{-1}, field engine domain
+    out[i] <-- in[0] * ... * in[i] 를 먼저 만들고 역원은 마지막 하나만 구한 후, 뒤에서부터 풀어낸다.
+        in[i]^{-1} = (in[0]...in[i])^{-1} * (in[0]...in[i-1])
+    1-inv + 3(n-1)-mul. out을 중간값 저장에 그대로 쓰므로 따로 메모리를 쓰지 않는다.
+    in의 원소는 0이 아니어야 하고, out과 in은 겹치면 안된다. */
+void inv_batch(BN* out, const BN* in, size_t n)
+{
+    BN acc, t;
+
+    if (n == 0) return;
+
+    // out[i] = in[0] * ... * in[i]
+    set_bn(&out[0], &in[0]);
+    for (size_t i = 1; i < n; i++) {
+        mulp_fe(&out[i], &out[i - 1], &in[i]);
+    }
+
+    // acc = (in[0] * ... * in[n-1])^{-1}
+    inv_fe(&acc, &out[n - 1]);
+
+    for (size_t i = n - 1; i > 0; i--) {
+        mulp_fe(&t, &acc, &out[i - 1]);         // in[i]^{-1}
+        mulp_fe(&acc, &acc, &in[i]);            // (in[0] * ... * in[i-1])^{-1}
+        set_bn(&out[i], &t);
+    }
+    set_bn(&out[0], &acc);
 }
 
     //* https://www.mobilefish.com/services/big_number_equation/big_number_equation.php#equation_output
@@ -1,3 +1,6 @@
+#ifndef ARITH_LIB_H
+#define ARITH_LIB_H
+
 #include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
@@ -5,6 +8,17 @@
 
 #define NUMWORD 8
 #define NUMWORD2 16
+#define NUMDWORD 4      // 64비트 limb 개수
+#define NUMDWORD2 8
+
+/*  -DECC_LIMB64: 64비트 limb (4 x 64, 128비트 곱) 사용. 기본은 32비트 limb.
+    d[]는 v[]를 64비트 단위로 본 것이므로 little endian + __int128 환경에서만 쓸 수 있다. */
+#ifdef ECC_LIMB64
+#if !defined(__SIZEOF_INT128__) || (__BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__)
+#error "ECC_LIMB64 requires unsigned __int128 and a little endian target"
+#endif
+typedef unsigned __int128 uint128_t;
+#endif
 
 //* consider :  const BN zero = {0};
 //* consider :  constant time implementation
@@ -12,18 +26,28 @@
 //todo ECC 구조체 뭐가 최선인지 생각해보기
 
 /* v: 들어갈 정수: v[n-1] || v[n-2] || ... || v[1] || v[0] 
+   d: v와 같은 메모리를 64비트 limb로 본 것: d[i] = v[2i+1] || v[2i]
    c: 캐리
    s: 부호- 양수 = 1, 음수 = -1 */
 typedef struct {
-    uint32_t v[NUMWORD];
+    union {
+        uint32_t v[NUMWORD];
+        uint64_t d[NUMDWORD];
+    };
     int32_t s;
 } BN;
 
 typedef struct {
-    uint32_t v[NUMWORD2];
+    union {
+        uint32_t v[NUMWORD2];
+        uint64_t d[NUMDWORD2];
+    };
     int32_t s;
 } BN2;
 
+/* montgomery domain의 원소 aR mod p (R = 2^256). 메모리 구조는 BN과 같다. */
+typedef BN BN_MONT;
+
 static const BN one  = {{1,0,0,0,0,0,0,0}, 0};
 static const BN zero = {{0,0,0,0,0,0,0,0}, 0};
 
@@ -31,11 +55,21 @@ static const BN P = {
     0xffffffff, 0xffffffff, 0xffffffff, 0x00000000, 
     0x00000000, 0x00000000, 0x00000001, 0xffffffff};
 
+// 군의 위수 n
+static const BN N = {
+    0xfc632551, 0xf3b9cac2, 0xa7179e84, 0xbce6faad, 
+    0xffffffff, 0xffffffff, 0x00000000, 0xffffffff};
+
 static const BN two_inv = {{
     0x00000000, 0x00000000, 0x80000000, 0x00000000, 
     0x00000000, 0x80000000, 0x80000000, 0x7fffffff}, 0};
 
+extern const BN RmodP;      // montgomery domain의 1
+extern const BN RRmodP;
+
 void set_bn(BN* dest, const BN* src);
+void cset_bn(BN* dest, const BN* src, uint32_t mask);
+void cswap_bn(BN* a, BN* b, uint32_t mask);
 int32_t ucmp(const BN* opa, const BN* opb);
 uint32_t rshift1(BN* ret, const BN* opa);
 uint32_t uadd(BN* ret, const BN* opa, const BN* opb);
@@ -43,10 +77,57 @@ uint32_t usub(BN* ret, const BN* opa, const BN* opb);
 void umul_os(BN2* ret, const BN* opa, const BN* opb);
 void umul_ps(BN2* ret, const BN* opa, const BN* opb);
 void usqr_ps(BN2* ret, const BN* opa);
+void umul_kara1(BN2* ret, const BN* opa, const BN* opb);
+void umul_kara2(BN2* ret, const BN* opa, const BN* opb);
+void usqr_kara1(BN2* ret, const BN* opa);
+void usqr_kara2(BN2* ret, const BN* opa);
 
 void addp(BN* ret, const BN* opa, const BN* opb);
 void subp(BN *ret, const BN* opa, const BN* opb); 
 void mod_fast(BN* ret, const BN2* opa);
 void mulp(BN *ret, const BN* opa, const BN* opb);
 void sqrp(BN *ret, const BN* opa);
-void inv(BN* ret, const BN* opa);
\ No newline at end of file
+void inv(BN* ret, const BN* opa);
+
+void to_mont(BN_MONT* ret, const BN* opa);
+void from_mont(BN* ret, const BN_MONT* opa);
+void mulp_mont(BN_MONT* ret, const BN_MONT* opa, const BN_MONT* opb);
+void sqrp_mont(BN_MONT* ret, const BN_MONT* opa);
+void mulp_solinas(BN* ret, const BN* opa, const BN* opb);
+void sqrp_solinas(BN* ret, const BN* opa);
+void mulp_add_mul_mont(BN_MONT* ret, const BN_MONT* opa, const BN_MONT* opb, const BN_MONT* opc, const BN_MONT* opd);
+void mulp_sub_mul_mont(BN_MONT* ret, const BN_MONT* opa, const BN_MONT* opb, const BN_MONT* opc, const BN_MONT* opd);
+void mulp_add_mul_solinas(BN* ret, const BN* opa, const BN* opb, const BN* opc, const BN* opd);
+void mulp_sub_mul_solinas(BN* ret, const BN* opa, const BN* opb, const BN* opc, const BN* opd);
+
+/*  점연산 계층(ECC_lib.c)이 쓰는 필드 곱셈 엔진. 빌드할 때 고른다.
+    기본      : montgomery, domain 원소는 aR mod p
+    -DECC_FIELD_SOLINAS : solinas (mod_fast), domain 원소는 a mod p 그대로
+    mulp_add_mul_fe / mulp_sub_mul_fe : ab +- cd, montgomery 에서는 reduction 한번 */
+#ifdef ECC_FIELD_SOLINAS
+#define mulp_fe     mulp_solinas
+#define sqrp_fe     sqrp_solinas
+#define mulp_add_mul_fe mulp_add_mul_solinas
+#define mulp_sub_mul_fe mulp_sub_mul_solinas
+#define to_fe       set_bn
+#define from_fe     set_bn
+#define fe_one      one
+#else
+#define mulp_fe     mulp_mont
+#define sqrp_fe     sqrp_mont
+#define mulp_add_mul_fe mulp_add_mul_mont
+#define mulp_sub_mul_fe mulp_sub_mul_mont
+#define to_fe       to_mont
+#define from_fe     from_mont
+#define fe_one      RmodP
+#endif
+
+void sqrp_n(BN* ret, const BN* opa, int n);
+void inv_fermat(BN* ret, const BN* opa);
+void inv_divstep(BN* ret, const BN* opa);
+void inv_divstep_n(BN* ret, const BN* opa);
+void invp(BN* ret, const BN* opa);
+void inv_fe(BN* ret, const BN* opa);
+void inv_batch(BN* out, const BN* in, size_t n);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,615 @@
+#include "arith_x8.h"
+
+#define M29 0x1fffffff
+
+// p, 2p, R'^2 mod p (R' = 2^261) 의 radix 2^29 표현
+static const uint32_t P29[X8_LIMBS] = {
+    0x1fffffff, 0x1fffffff, 0x1fffffff, 0x000001ff, 0x00000000,
+    0x00000000, 0x00040000, 0x1fe00000, 0x00ffffff};
+
+static const uint32_t P29x2[X8_LIMBS] = {
+    0x1ffffffe, 0x1fffffff, 0x1fffffff, 0x000003ff, 0x00000000,
+    0x00000000, 0x00080000, 0x1fc00000, 0x01ffffff};
+
+static const uint32_t RR29[X8_LIMBS] = {
+    0x00000c00, 0x00000000, 0x1fff0000, 0x1fdfffff, 0x1fbfffff,
+    0x1fffffff, 0x1fffffff, 0x1ffffffe, 0x00000013};
+
+/* BN --> radix 2^29, lane l에 넣음 */
+static void bn_to_r29(BN_X8* ret, int l, const BN* opa)
+{
+    uint64_t acc = 0;
+    int bits = 0, j = 0;
+
+    for (int i = 0; i < NUMWORD; i++) {
+        acc |= (uint64_t)opa->v[i] << bits;
+        bits += 32;
+        while (bits >= X8_RADIX) {
+            ret->v[j++][l] = (uint32_t)acc & M29;
+            acc >>= X8_RADIX;
+            bits -= X8_RADIX;
+        }
+    }
+    ret->v[j][l] = (uint32_t)acc;
+}
+
+/* radix 2^29 lane l --> BN, limb는 정규화되어 있고 값은 2^256 미만 */
+static void r29_to_bn(BN* ret, const BN_X8* opa, int l)
+{
+    uint64_t acc = 0;
+    int bits = 0, j = 0;
+
+    for (int i = 0; i < X8_LIMBS; i++) {
+        acc |= (uint64_t)opa->v[i][l] << bits;
+        bits += X8_RADIX;
+        while (bits >= 32 && j < NUMWORD) {
+            ret->v[j++] = (uint32_t)acc;
+            acc >>= 32;
+            bits -= 32;
+        }
+    }
+    ret->s = 0;
+}
+
+/*______________________________________________________________
+    일반 C 코드: lane 하나씩 계산
+________________________________________________________________*/
+
+/*  s in (-2^261, 4p) 를 정규화한 후, 2p 이상이면 2p를 뺌 --> [0, 2p)
+    limb는 부호 있는 값이고 캐리는 산술 시프트로 전파한다. */
+static void red2p_lane(BN_X8* ret, int l, int32_t s[X8_LIMBS])
+{
+    int32_t d[X8_LIMBS];
+    uint32_t mask = 0;
+
+    for (int i = 0; i < X8_LIMBS - 1; i++) {
+        s[i + 1] += s[i] >> X8_RADIX;
+        s[i] &= M29;
+    }
+    for (int i = 0; i < X8_LIMBS; i++) {
+        d[i] = s[i] - (int32_t)P29x2[i];
+    }
+    for (int i = 0; i < X8_LIMBS - 1; i++) {
+        d[i + 1] += d[i] >> X8_RADIX;
+        d[i] &= M29;
+    }
+
+    // d < 0 이면 s를 그대로 씀
+    mask = (uint32_t)(d[X8_LIMBS - 1] >> 31);
+    for (int i = 0; i < X8_LIMBS; i++) {
+        ret->v[i][l] = ((uint32_t)s[i] & mask) | ((uint32_t)d[i] & ~mask);
+    }
+}
+
+static void addp_x8_c(BN_X8* ret, const BN_X8* opa, const BN_X8* opb)
+{
+    int32_t s[X8_LIMBS];
+
+    for (int l = 0; l < X8_LANES; l++) {
+        for (int i = 0; i < X8_LIMBS; i++) {
+            s[i] = (int32_t)(opa->v[i][l] + opb->v[i][l]);
+        }
+        red2p_lane(ret, l, s);
+    }
+}
+
+/* a - b + 2p in (0, 4p) */
+static void subp_x8_c(BN_X8* ret, const BN_X8* opa, const BN_X8* opb)
+{
+    int32_t s[X8_LIMBS];
+
+    for (int l = 0; l < X8_LANES; l++) {
+        for (int i = 0; i < X8_LIMBS; i++) {
+            s[i] = (int32_t)(opa->v[i][l] + P29x2[i]) - (int32_t)opb->v[i][l];
+        }
+        red2p_lane(ret, l, s);
+    }
+}
+
+/*  montgomery reduction of t[0..17]: p' = -p^{-1} mod 2^29 = 1 이므로 m = t[i] mod 2^29
+    (t + mp) / R' 는 입력이 2p 미만이면 2p 미만이다. */
+static void mont_lane(BN_X8* ret, int l, uint64_t t[2*X8_LIMBS])
+{
+    uint64_t m = 0;
+
+    for (int i = 0; i < X8_LIMBS; i++) {
+        m = t[i] & M29;
+        for (int j = 0; j < X8_LIMBS; j++) {
+            t[i + j] += m * P29[j];
+        }
+        t[i + 1] += t[i] >> X8_RADIX;
+    }
+    for (int i = X8_LIMBS; i < 2*X8_LIMBS - 1; i++) {
+        t[i + 1] += t[i] >> X8_RADIX;
+        ret->v[i - X8_LIMBS][l] = (uint32_t)t[i] & M29;
+    }
+    ret->v[X8_LIMBS - 1][l] = (uint32_t)t[2*X8_LIMBS - 1];
+}
+
+static void mulp_x8_c(BN_X8* ret, const BN_X8* opa, const BN_X8* opb)
+{
+    uint64_t t[2*X8_LIMBS];
+
+    for (int l = 0; l < X8_LANES; l++) {
+        memset(t, 0, sizeof(t));
+        for (int i = 0; i < X8_LIMBS; i++) {
+            for (int j = 0; j < X8_LIMBS; j++) {
+                t[i + j] += (uint64_t)opa->v[i][l] * opb->v[j][l];
+            }
+        }
+        mont_lane(ret, l, t);
+    }
+}
+
+/* 제곱은 a_i * a_j (i < j) 를 한번만 곱하고 2배 */
+static void sqrp_x8_c(BN_X8* ret, const BN_X8* opa)
+{
+    uint64_t t[2*X8_LIMBS];
+
+    for (int l = 0; l < X8_LANES; l++) {
+        memset(t, 0, sizeof(t));
+        for (int i = 0; i < X8_LIMBS; i++) {
+            t[2*i] += (uint64_t)opa->v[i][l] * opa->v[i][l];
+            for (int j = i + 1; j < X8_LIMBS; j++) {
+                t[i + j] += (uint64_t)opa->v[i][l] * (2 * opa->v[j][l]);
+            }
+        }
+        mont_lane(ret, l, t);
+    }
+}
+
+/*______________________________________________________________
+    AVX2 코드: 8 lane을 한번에 계산
+    덧셈/뺄셈은 32비트 lane 8개를 그대로, 곱셈은 _mm256_mul_epu32 (32 x 32 = 64) 가
+    64비트 lane의 하위 32비트만 곱하므로 짝수 lane과 홀수 lane (>> 32)을 따로 계산 후 합친다.
+________________________________________________________________*/
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(ECC_X8_NO_AVX2)
+#define X8_AVX2
+#include <immintrin.h>
+
+#define TARGET_AVX2 __attribute__((target("avx2")))
+
+TARGET_AVX2 static void red2p_avx2(BN_X8* ret, __m256i s[X8_LIMBS])
+{
+    const __m256i m29 = _mm256_set1_epi32(M29);
+    __m256i d[X8_LIMBS];
+    __m256i mask;
+
+    for (int i = 0; i < X8_LIMBS - 1; i++) {
+        s[i + 1] = _mm256_add_epi32(s[i + 1], _mm256_srai_epi32(s[i], X8_RADIX));
+        s[i] = _mm256_and_si256(s[i], m29);
+    }
+    for (int i = 0; i < X8_LIMBS; i++) {
+        d[i] = _mm256_sub_epi32(s[i], _mm256_set1_epi32((int32_t)P29x2[i]));
+    }
+    for (int i = 0; i < X8_LIMBS - 1; i++) {
+        d[i + 1] = _mm256_add_epi32(d[i + 1], _mm256_srai_epi32(d[i], X8_RADIX));
+        d[i] = _mm256_and_si256(d[i], m29);
+    }
+
+    // d < 0 이면 s를 그대로 씀
+    mask = _mm256_srai_epi32(d[X8_LIMBS - 1], 31);
+    for (int i = 0; i < X8_LIMBS; i++) {
+        _mm256_storeu_si256((__m256i*)ret->v[i], _mm256_blendv_epi8(d[i], s[i], mask));
+    }
+}
+
+TARGET_AVX2 static void addp_x8_avx2(BN_X8* ret, const BN_X8* opa, const BN_X8* opb)
+{
+    __m256i s[X8_LIMBS];
+
+    for (int i = 0; i < X8_LIMBS; i++) {
+        s[i] = _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)opa->v[i]),
+                                _mm256_loadu_si256((const __m256i*)opb->v[i]));
+    }
+    red2p_avx2(ret, s);
+}
+
+TARGET_AVX2 static void subp_x8_avx2(BN_X8* ret, const BN_X8* opa, const BN_X8* opb)
+{
+    __m256i s[X8_LIMBS];
+
+    for (int i = 0; i < X8_LIMBS; i++) {
+        s[i] = _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)opa->v[i]),
+                                _mm256_set1_epi32((int32_t)P29x2[i]));
+        s[i] = _mm256_sub_epi32(s[i], _mm256_loadu_si256((const __m256i*)opb->v[i]));
+    }
+    red2p_avx2(ret, s);
+}
+
+/* 64비트 lane 4개의 t[0..17] montgomery reduction, 결과는 r[0..8] (64비트 lane의 하위 32비트) */
+TARGET_AVX2 static void mont_avx2(__m256i r[X8_LIMBS], __m256i t[2*X8_LIMBS])
+{
+    const __m256i m29 = _mm256_set1_epi64x(M29);
+    __m256i m;
+
+    for (int i = 0; i < X8_LIMBS; i++) {
+        m = _mm256_and_si256(t[i], m29);
+        for (int j = 0; j < X8_LIMBS; j++) {
+            if (P29[j] == 0) continue;
+            t[i + j] = _mm256_add_epi64(t[i + j], _mm256_mul_epu32(m, _mm256_set1_epi64x(P29[j])));
+        }
+        t[i + 1] = _mm256_add_epi64(t[i + 1], _mm256_srli_epi64(t[i], X8_RADIX));
+    }
+    for (int i = X8_LIMBS; i < 2*X8_LIMBS - 1; i++) {
+        t[i + 1] = _mm256_add_epi64(t[i + 1], _mm256_srli_epi64(t[i], X8_RADIX));
+        r[i - X8_LIMBS] = _mm256_and_si256(t[i], m29);
+    }
+    r[X8_LIMBS - 1] = t[2*X8_LIMBS - 1];
+}
+
+/* 짝수 lane (re)과 홀수 lane (ro)의 결과를 32비트 lane 8개로 합침 */
+TARGET_AVX2 static void store_x8_avx2(BN_X8* ret, const __m256i re[X8_LIMBS], const __m256i ro[X8_LIMBS])
+{
+    for (int i = 0; i < X8_LIMBS; i++) {
+        _mm256_storeu_si256((__m256i*)ret->v[i],
+                            _mm256_blend_epi32(re[i], _mm256_slli_epi64(ro[i], 32), 0xAA));
+    }
+}
+
+TARGET_AVX2 static void mulp_x8_avx2(BN_X8* ret, const BN_X8* opa, const BN_X8* opb)
+{
+    __m256i ae[X8_LIMBS], ao[X8_LIMBS], be[X8_LIMBS], bo[X8_LIMBS];
+    __m256i te[2*X8_LIMBS], to[2*X8_LIMBS];
+    __m256i re[X8_LIMBS], ro[X8_LIMBS];
+
+    for (int i = 0; i < X8_LIMBS; i++) {
+        ae[i] = _mm256_loadu_si256((const __m256i*)opa->v[i]);
+        be[i] = _mm256_loadu_si256((const __m256i*)opb->v[i]);
+        ao[i] = _mm256_srli_epi64(ae[i], 32);
+        bo[i] = _mm256_srli_epi64(be[i], 32);
+    }
+    for (int k = 0; k < 2*X8_LIMBS; k++) {
+        te[k] = _mm256_setzero_si256();
+        to[k] = _mm256_setzero_si256();
+    }
+
+    for (int i = 0; i < X8_LIMBS; i++) {
+        for (int j = 0; j < X8_LIMBS; j++) {
+            te[i + j] = _mm256_add_epi64(te[i + j], _mm256_mul_epu32(ae[i], be[j]));
+            to[i + j] = _mm256_add_epi64(to[i + j], _mm256_mul_epu32(ao[i], bo[j]));
+        }
+    }
+
+    mont_avx2(re, te);
+    mont_avx2(ro, to);
+    store_x8_avx2(ret, re, ro);
+}
+
+TARGET_AVX2 static void sqrp_x8_avx2(BN_X8* ret, const BN_X8* opa)
+{
+    __m256i ae[X8_LIMBS], ao[X8_LIMBS], ae2[X8_LIMBS], ao2[X8_LIMBS];
+    __m256i te[2*X8_LIMBS], to[2*X8_LIMBS];
+    __m256i re[X8_LIMBS], ro[X8_LIMBS];
+
+    for (int i = 0; i < X8_LIMBS; i++) {
+        ae[i] = _mm256_loadu_si256((const __m256i*)opa->v[i]);
+        ao[i] = _mm256_srli_epi64(ae[i], 32);
+        ae2[i] = _mm256_add_epi32(ae[i], ae[i]);        // 2a_i < 2^30, 하위 32비트에 들어감
+        ao2[i] = _mm256_add_epi64(ao[i], ao[i]);
+    }
+    for (int k = 0; k < 2*X8_LIMBS; k++) {
+        te[k] = _mm256_setzero_si256();
+        to[k] = _mm256_setzero_si256();
+    }
+
+    for (int i = 0; i < X8_LIMBS; i++) {
+        te[2*i] = _mm256_add_epi64(te[2*i], _mm256_mul_epu32(ae[i], ae[i]));
+        to[2*i] = _mm256_add_epi64(to[2*i], _mm256_mul_epu32(ao[i], ao[i]));
+        for (int j = i + 1; j < X8_LIMBS; j++) {
+            te[i + j] = _mm256_add_epi64(te[i + j], _mm256_mul_epu32(ae[i], ae2[j]));
+            to[i + j] = _mm256_add_epi64(to[i + j], _mm256_mul_epu32(ao[i], ao2[j]));
+        }
+    }
+
+    mont_avx2(re, te);
+    mont_avx2(ro, to);
+    store_x8_avx2(ret, re, ro);
+}
+#endif
+
+/*______________________________________________________________
+    AVX-512 IFMA 코드: radix 2^52, 64비트 lane 8개 = zmm 하나
+    _mm512_madd52lo_epu64(t, a, b) = t + (a * b 의 하위 52비트)
+    _mm512_madd52hi_epu64(t, a, b) = t + (a * b 의 상위 52비트), a, b 는 하위 52비트만 사용
+    p' = -p^{-1} mod 2^52 = 1 이므로 reduction의 m = t[i] mod 2^52 이다.
+________________________________________________________________*/
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(ECC_X8_NO_IFMA)
+#define X8_IFMA
+#include <immintrin.h>
+
+#define M52 0xfffffffffffffULL
+
+#define TARGET_IFMA __attribute__((target("avx512f,avx512ifma")))
+
+// p, 2p, R'^2 mod p (R' = 2^260) 의 radix 2^52 표현
+static const uint64_t P52[X8_LIMBS52] = {
+    0xfffffffffffffULL, 0x00fffffffffffULL, 0x0000000000000ULL, 0x0001000000000ULL, 0x0ffffffff0000ULL};
+
+static const uint64_t P52x2[X8_LIMBS52] = {
+    0xffffffffffffeULL, 0x01fffffffffffULL, 0x0000000000000ULL, 0x0002000000000ULL, 0x1fffffffe0000ULL};
+
+static const uint64_t RR52[X8_LIMBS52] = {
+    0x0000000000300ULL, 0xffffffff00000ULL, 0xffffefffffffbULL, 0xfdfffffffffffULL, 0x0000004ffffffULL};
+
+/* BN --> radix 2^52, lane l에 넣음 */
+static void bn_to_r52(BN_X8* ret, int l, const BN* opa)
+{
+    for (int i = 0; i < X8_LIMBS52; i++) {
+        int bit = i * X8_RADIX52, k = bit / 64, sh = bit % 64;
+        uint64_t r = opa->d[k] >> sh;
+
+        if (sh > 64 - X8_RADIX52 && k + 1 < NUMDWORD) r |= opa->d[k + 1] << (64 - sh);
+        ret->w[i][l] = r & M52;
+    }
+}
+
+/* radix 2^52 lane l --> BN, limb는 정규화되어 있고 값은 2^256 미만 */
+static void r52_to_bn(BN* ret, const BN_X8* opa, int l)
+{
+    memset(ret, 0, sizeof(BN));
+    for (int i = 0; i < X8_LIMBS52; i++) {
+        int bit = i * X8_RADIX52, k = bit / 64, sh = bit % 64;
+        uint64_t r = opa->w[i][l];
+
+        ret->d[k] |= r << sh;
+        if (sh > 64 - X8_RADIX52 && k + 1 < NUMDWORD) ret->d[k + 1] |= r >> (64 - sh);
+    }
+}
+
+/* s in (-2^260, 4p) 를 정규화한 후, 2p 이상이면 2p를 뺌 --> [0, 2p) */
+TARGET_IFMA static void red2p_ifma(BN_X8* ret, __m512i s[X8_LIMBS52])
+{
+    const __m512i m52 = _mm512_set1_epi64(M52);
+    __m512i d[X8_LIMBS52];
+    __mmask8 neg;
+
+    for (int i = 0; i < X8_LIMBS52 - 1; i++) {
+        s[i + 1] = _mm512_add_epi64(s[i + 1], _mm512_srai_epi64(s[i], X8_RADIX52));
+        s[i] = _mm512_and_si512(s[i], m52);
+    }
+    for (int i = 0; i < X8_LIMBS52; i++) {
+        d[i] = _mm512_sub_epi64(s[i], _mm512_set1_epi64(P52x2[i]));
+    }
+    for (int i = 0; i < X8_LIMBS52 - 1; i++) {
+        d[i + 1] = _mm512_add_epi64(d[i + 1], _mm512_srai_epi64(d[i], X8_RADIX52));
+        d[i] = _mm512_and_si512(d[i], m52);
+    }
+
+    // d < 0 인 lane은 s를 그대로 씀
+    neg = _mm512_cmplt_epi64_mask(d[X8_LIMBS52 - 1], _mm512_setzero_si512());
+    for (int i = 0; i < X8_LIMBS52; i++) {
+        _mm512_storeu_si512(ret->w[i], _mm512_mask_blend_epi64(neg, d[i], s[i]));
+    }
+}
+
+TARGET_IFMA static void addp_x8_ifma(BN_X8* ret, const BN_X8* opa, const BN_X8* opb)
+{
+    __m512i s[X8_LIMBS52];
+
+    for (int i = 0; i < X8_LIMBS52; i++) {
+        s[i] = _mm512_add_epi64(_mm512_loadu_si512(opa->w[i]), _mm512_loadu_si512(opb->w[i]));
+    }
+    red2p_ifma(ret, s);
+}
+
+TARGET_IFMA static void subp_x8_ifma(BN_X8* ret, const BN_X8* opa, const BN_X8* opb)
+{
+    __m512i s[X8_LIMBS52];
+
+    for (int i = 0; i < X8_LIMBS52; i++) {
+        s[i] = _mm512_add_epi64(_mm512_loadu_si512(opa->w[i]), _mm512_set1_epi64(P52x2[i]));
+        s[i] = _mm512_sub_epi64(s[i], _mm512_loadu_si512(opb->w[i]));
+    }
+    red2p_ifma(ret, s);
+}
+
+/* t[0..9] montgomery reduction --> ret, 입력이 2p 미만이면 결과도 2p 미만 */
+TARGET_IFMA static void mont_ifma(BN_X8* ret, __m512i t[2*X8_LIMBS52])
+{
+    const __m512i m52 = _mm512_set1_epi64(M52);
+    __m512i m, pj;
+
+    for (int i = 0; i < X8_LIMBS52; i++) {
+        m = _mm512_and_si512(t[i], m52);
+        for (int j = 0; j < X8_LIMBS52; j++) {
+            if (P52[j] == 0) continue;
+            pj = _mm512_set1_epi64(P52[j]);
+            t[i + j] = _mm512_madd52lo_epu64(t[i + j], m, pj);
+            t[i + j + 1] = _mm512_madd52hi_epu64(t[i + j + 1], m, pj);
+        }
+        t[i + 1] = _mm512_add_epi64(t[i + 1], _mm512_srli_epi64(t[i], X8_RADIX52));
+    }
+    for (int i = X8_LIMBS52; i < 2*X8_LIMBS52 - 1; i++) {
+        t[i + 1] = _mm512_add_epi64(t[i + 1], _mm512_srli_epi64(t[i], X8_RADIX52));
+        _mm512_storeu_si512(ret->w[i - X8_LIMBS52], _mm512_and_si512(t[i], m52));
+    }
+    _mm512_storeu_si512(ret->w[X8_LIMBS52 - 1], t[2*X8_LIMBS52 - 1]);
+}
+
+TARGET_IFMA static void mulp_x8_ifma(BN_X8* ret, const BN_X8* opa, const BN_X8* opb)
+{
+    __m512i a[X8_LIMBS52], b[X8_LIMBS52], t[2*X8_LIMBS52];
+
+    for (int i = 0; i < X8_LIMBS52; i++) {
+        a[i] = _mm512_loadu_si512(opa->w[i]);
+        b[i] = _mm512_loadu_si512(opb->w[i]);
+    }
+    for (int k = 0; k < 2*X8_LIMBS52; k++) t[k] = _mm512_setzero_si512();
+
+    for (int i = 0; i < X8_LIMBS52; i++) {
+        for (int j = 0; j < X8_LIMBS52; j++) {
+            t[i + j] = _mm512_madd52lo_epu64(t[i + j], a[i], b[j]);
+            t[i + j + 1] = _mm512_madd52hi_epu64(t[i + j + 1], a[i], b[j]);
+        }
+    }
+
+    mont_ifma(ret, t);
+}
+
+/* 제곱: a_i * a_j (i < j) 를 한번만 곱해서 2배 한 후 a_i^2 를 더함 */
+TARGET_IFMA static void sqrp_x8_ifma(BN_X8* ret, const BN_X8* opa)
+{
+    __m512i a[X8_LIMBS52], t[2*X8_LIMBS52];
+
+    for (int i = 0; i < X8_LIMBS52; i++) a[i] = _mm512_loadu_si512(opa->w[i]);
+    for (int k = 0; k < 2*X8_LIMBS52; k++) t[k] = _mm512_setzero_si512();
+
+    for (int i = 0; i < X8_LIMBS52; i++) {
+        for (int j = i + 1; j < X8_LIMBS52; j++) {
+            t[i + j] = _mm512_madd52lo_epu64(t[i + j], a[i], a[j]);
+            t[i + j + 1] = _mm512_madd52hi_epu64(t[i + j + 1], a[i], a[j]);
+        }
+    }
+    for (int k = 0; k < 2*X8_LIMBS52; k++) t[k] = _mm512_add_epi64(t[k], t[k]);
+    for (int i = 0; i < X8_LIMBS52; i++) {
+        t[2*i] = _mm512_madd52lo_epu64(t[2*i], a[i], a[i]);
+        t[2*i + 1] = _mm512_madd52hi_epu64(t[2*i + 1], a[i], a[i]);
+    }
+
+    mont_ifma(ret, t);
+}
+#endif
+
+/*______________________________________________________________
+    runtime dispatch
+________________________________________________________________*/
+
+static int x8_cur = -1;
+
+/* CPU 가 지원하는 backend 를 고른다: IFMA --> AVX2 --> 일반 C */
+static int x8_best(void)
+{
+    int backend = X8_BACKEND_C;
+
+#ifdef X8_AVX2
+    if (__builtin_cpu_supports("avx2")) backend = X8_BACKEND_AVX2;
+#endif
+#ifdef X8_IFMA
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512ifma")) backend = X8_BACKEND_IFMA;
+#endif
+    return backend;
+}
+
+int x8_backend(void)
+{
+    if (x8_cur < 0) x8_cur = x8_best();
+
+    return x8_cur;
+}
+
+/*  backend 를 바꾼다 (테스트에서 backend 별로 비교할 때). 이 CPU/빌드에서 쓸 수 없으면 -1 리턴하고 그대로 둔다.
+    BN_X8 의 표현이 backend 마다 다르므로 바꾸기 전에 pack 한 값은 다시 pack 해야 한다. */
+int x8_set_backend(int backend)
+{
+    int best = x8_best();
+
+    if (backend < X8_BACKEND_C || backend > best) return -1;
+#ifndef X8_AVX2
+    if (backend == X8_BACKEND_AVX2) return -1;
+#endif
+    x8_cur = backend;
+    return 0;
+}
+
+void addp_x8(BN_X8* ret, const BN_X8* opa, const BN_X8* opb)
+{
+    switch (x8_backend()) {
+#ifdef X8_IFMA
+    case X8_BACKEND_IFMA: addp_x8_ifma(ret, opa, opb); return;
+#endif
+#ifdef X8_AVX2
+    case X8_BACKEND_AVX2: addp_x8_avx2(ret, opa, opb); return;
+#endif
+    default: addp_x8_c(ret, opa, opb);
+    }
+}
+
+void subp_x8(BN_X8* ret, const BN_X8* opa, const BN_X8* opb)
+{
+    switch (x8_backend()) {
+#ifdef X8_IFMA
+    case X8_BACKEND_IFMA: subp_x8_ifma(ret, opa, opb); return;
+#endif
+#ifdef X8_AVX2
+    case X8_BACKEND_AVX2: subp_x8_avx2(ret, opa, opb); return;
+#endif
+    default: subp_x8_c(ret, opa, opb);
+    }
+}
+
+void mulp_x8(BN_X8* ret, const BN_X8* opa, const BN_X8* opb)
+{
+    switch (x8_backend()) {
+#ifdef X8_IFMA
+    case X8_BACKEND_IFMA: mulp_x8_ifma(ret, opa, opb); return;
+#endif
+#ifdef X8_AVX2
+    case X8_BACKEND_AVX2: mulp_x8_avx2(ret, opa, opb); return;
+#endif
+    default: mulp_x8_c(ret, opa, opb);
+    }
+}
+
+void sqrp_x8(BN_X8* ret, const BN_X8* opa)
+{
+    switch (x8_backend()) {
+#ifdef X8_IFMA
+    case X8_BACKEND_IFMA: sqrp_x8_ifma(ret, opa); return;
+#endif
+#ifdef X8_AVX2
+    case X8_BACKEND_AVX2: sqrp_x8_avx2(ret, opa); return;
+#endif
+    default: sqrp_x8_c(ret, opa);
+    }
+}
+
+/*  8개의 BN (a mod p) --> lane montgomery domain: aR' = a x R'^2  */
+void pack_x8(BN_X8* ret, const BN in[X8_LANES])
+{
+    BN_X8 t, rr;
+
+#ifdef X8_IFMA
+    if (x8_backend() == X8_BACKEND_IFMA) {
+        for (int l = 0; l < X8_LANES; l++) {
+            bn_to_r52(&t, l, &in[l]);
+            for (int i = 0; i < X8_LIMBS52; i++) rr.w[i][l] = RR52[i];
+        }
+        mulp_x8(ret, &t, &rr);
+        return;
+    }
+#endif
+    for (int l = 0; l < X8_LANES; l++) {
+        bn_to_r29(&t, l, &in[l]);
+        for (int i = 0; i < X8_LIMBS; i++) rr.v[i][l] = RR29[i];
+    }
+    mulp_x8(ret, &t, &rr);
+}
+
+/*  lane montgomery domain --> 8개의 BN: a = aR' x 1, 결과는 p 이하이므로 마지막에 p를 한번 뺌 */
+void unpack_x8(BN out[X8_LANES], const BN_X8* opa)
+{
+    BN_X8 t, o;
+    BN r, r_sub;
+    uint32_t borrow = 0;
+
+    memset(&o, 0, sizeof(o));
+#ifdef X8_IFMA
+    if (x8_backend() == X8_BACKEND_IFMA) {
+        for (int l = 0; l < X8_LANES; l++) o.w[0][l] = 1;
+    } else
+#endif
+    for (int l = 0; l < X8_LANES; l++) o.v[0][l] = 1;
+    mulp_x8(&t, opa, &o);
+
+    for (int l = 0; l < X8_LANES; l++) {
+#ifdef X8_IFMA
+        if (x8_backend() == X8_BACKEND_IFMA) r52_to_bn(&r, &t, l);
+        else
+#endif
+        r29_to_bn(&r, &t, l);
+        borrow = usub(&r_sub, &r, &P);
+        cset_bn(&r, &r_sub, borrow - 1);
+        set_bn(&out[l], &r);
+    }
+}
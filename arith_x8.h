@@ -0,0 +1,47 @@
+#ifndef ARITH_X8_H
+#define ARITH_X8_H
+
+#include "arith_lib.h"
+
+/*  8개의 서로 다른 필드 원소를 한번에 계산하는 multi-buffer 필드 연산.
+    한 원소는 29비트 limb 9개 (radix 2^29, 261비트)로 나누고, 같은 limb끼리 8 lane으로 모아둔다.
+        v[i][l] : lane l의 i번째 limb
+    limb에 여유 비트가 있어 덧셈 캐리를 바로 전파하지 않아도 되고, AVX2 32비트 lane 하나에 limb 하나가 들어간다.
+
+    값은 montgomery domain (R' = 2^261)에 있고, [0, 2p) 범위로 느슨하게 유지한다. (4p < R' 이므로 mulp_x8은 뺄셈이 필요 없음)
+    BN과의 변환은 pack_x8 / unpack_x8 에서만 한다.
+
+    AVX-512 IFMA (vpmadd52luq/huq)를 지원하는 CPU에서는 52비트 limb 5개 (radix 2^52, R' = 2^260) 표현을 쓴다.
+        w[i][l] : lane l의 i번째 52비트 limb, 64비트 lane 8개가 zmm 하나
+    backend는 실행 중에 한번 고른다: IFMA --> AVX2 --> 일반 C (radix 2^29).
+    BN_X8 안의 표현은 backend에 따라 다르므로 값은 pack_x8 / unpack_x8 로만 읽고 쓴다. */
+
+#define X8_LANES 8
+#define X8_LIMBS 9
+#define X8_RADIX 29
+#define X8_LIMBS52 5
+#define X8_RADIX52 52
+
+#define X8_BACKEND_C    0
+#define X8_BACKEND_AVX2 1
+#define X8_BACKEND_IFMA 2
+
+typedef struct {
+    union {
+        uint32_t v[X8_LIMBS][X8_LANES];         // radix 2^29: 일반 C, AVX2
+        uint64_t w[X8_LIMBS52][X8_LANES];       // radix 2^52: AVX-512 IFMA
+    };
+} BN_X8;
+
+void pack_x8(BN_X8* ret, const BN in[X8_LANES]);
+void unpack_x8(BN out[X8_LANES], const BN_X8* opa);
+
+void addp_x8(BN_X8* ret, const BN_X8* opa, const BN_X8* opb);
+void subp_x8(BN_X8* ret, const BN_X8* opa, const BN_X8* opb);
+void mulp_x8(BN_X8* ret, const BN_X8* opa, const BN_X8* opb);
+void sqrp_x8(BN_X8* ret, const BN_X8* opa);
+
+int x8_backend(void);
+int x8_set_backend(int backend);
+
+#endif
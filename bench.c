@@ -0,0 +1,287 @@
+#include "arith_lib.h"
+#include "field_p256.h"
+#include "curve_secp256k1_glv.h"
+#include <time.h>
+
+/*  연산별 속도와 분기 예측 실패 횟수 측정
+    분기 예측 실패는 linux perf_event_open (PERF_COUNT_HW_BRANCH_MISSES, user 영역만) 으로 센다.
+    perf를 쓸 수 없는 환경이면 시간만 출력한다. */
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#define BENCH_N     (1 << 20)
+#define BENCH_SET   1024        // 입력 집합 크기: 분기 예측기가 외우지 못하도록 충분히 크게
+#define BENCH_EC_N  256         // 스칼라 곱셈 반복 횟수
+
+static int perf_fd = -1;
+
+static void perf_open(void)
+{
+#ifdef __linux__
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    perf_fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+}
+
+static void perf_start(void)
+{
+#ifdef __linux__
+    if (perf_fd < 0) return;
+    ioctl(perf_fd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(perf_fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+}
+
+static long long perf_stop(void)
+{
+    long long count = -1;
+
+#ifdef __linux__
+    if (perf_fd < 0) return -1;
+    ioctl(perf_fd, PERF_EVENT_IOC_DISABLE, 0);
+    if (read(perf_fd, &count, sizeof(count)) != sizeof(count)) count = -1;
+#endif
+    return count;
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* xorshift 난수로 [0, p) 원소 채우기 */
+static uint64_t rnd_state = 0x2545f4914f6cdd1dULL;
+
+static uint32_t rnd32(void)
+{
+    rnd_state ^= rnd_state << 13;
+    rnd_state ^= rnd_state >> 7;
+    rnd_state ^= rnd_state << 17;
+    return (uint32_t)(rnd_state >> 16);
+}
+
+static void rnd_bn(BN* a)
+{
+    BN t;
+
+    do {
+        for (int i = 0; i < NUMWORD; i++) t.v[i] = rnd32();
+    } while (usub(a, &t, &P) == 0);     // t >= p 이면 다시
+    set_bn(a, &t);
+    a->s = 0;
+}
+
+static BN in_a[BENCH_SET], in_b[BENCH_SET];
+
+static void report(const char* name, int cnt, double ns, long long miss)
+{
+    if (miss < 0) printf("%-10s %8.1f ns/op\n", name, ns / cnt);
+    else printf("%-10s %8.1f ns/op  %6.3f branch-miss/op\n", name, ns / cnt, (double)miss / cnt);
+}
+
+/* 입력 i, i+1 을 쓰고 결과를 in_a 에 다시 써서 컴파일러가 반복을 없애지 못하게 함 */
+#define BENCH_OP(name, stmt)    BENCH_OP_N(name, BENCH_N, stmt)
+#define BENCH_OP_N(name, cnt, stmt)                             \
+    do {                                                        \
+        double t0 = 0;                                          \
+        long long miss = 0;                                     \
+        perf_start();                                           \
+        t0 = now_ns();                                          \
+        for (int n = 0; n < (cnt); n++) {                       \
+            int i = n & (BENCH_SET - 1);                        \
+            BN* a = &in_a[i];                                   \
+            BN* b = &in_b[(i * 7 + 3) & (BENCH_SET - 1)];       \
+            (void)a; (void)b;                                   \
+            stmt;                                               \
+        }                                                       \
+        t0 = now_ns() - t0;                                     \
+        miss = perf_stop();                                     \
+        report(name, (cnt), t0, miss);                          \
+    } while (0)
+
+/*  예전 (분기 있는) uadd / usub / ucmp / addp / subp 의 사본, 지금의 분기 없는 버전과 나란히 잰다.
+    ucmp 는 최상위 워드에서 바로 끝나고, addp / subp 는 carry 와 비교 결과에 따라 분기한다. */
+static int32_t old_ucmp(const BN* opa, const BN* opb)
+{
+    for (int i = NUMWORD - 1; i >= 0; i--) {
+        if (opa->v[i] > opb->v[i]) return 1;
+        if (opa->v[i] < opb->v[i]) return -1;
+    }
+    return 0;
+}
+
+static uint32_t old_uadd(BN* ret, const BN* opa, const BN* opb)
+{
+    BN r = {0};
+    uint32_t carry = 0;
+
+#ifdef ECC_LIMB64
+    uint128_t t = 0;
+
+    for (size_t i = 0; i < NUMDWORD; i++) {
+        t = (uint128_t)opa->d[i] + opb->d[i] + carry;
+        r.d[i] = (uint64_t)t;
+        carry = (uint32_t)(t >> 64);
+    }
+#else
+    for (size_t i = 0; i < NUMWORD; i++) {
+        r.v[i] = opa->v[i] + opb->v[i] + carry;
+        carry = (opa->v[i] + opb->v[i] + carry < carry) +
+              (opa->v[i] + opb->v[i] < opa->v[i]);
+    }
+#endif
+
+    set_bn(ret, &r);
+    return carry;
+}
+
+static uint32_t old_usub(BN* ret, const BN* opa, const BN* opb)
+{
+    BN r;
+    uint32_t carry = 0;
+
+#ifdef ECC_LIMB64
+    uint128_t t = 0;
+
+    for (int i = 0; i < NUMDWORD; i++) {
+        t = (uint128_t)opa->d[i] - opb->d[i] - carry;
+        r.d[i] = (uint64_t)t;
+        carry = (uint32_t)(t >> 64) & 1;
+    }
+#else
+    for (int i = 0; i < NUMWORD; i++) {
+        r.v[i] = opa->v[i] - opb->v[i] - carry;
+        carry = (opa->v[i] < opb->v[i]) ||
+              ((opa->v[i] == opb->v[i]) && (carry == 1));
+    }
+#endif
+
+    set_bn(ret, &r);
+    return carry;
+}
+
+static void old_addp(BN* ret, const BN* opa, const BN* opb)
+{
+    BN r;
+
+    if (old_uadd(&r, opa, opb) == 1 || old_ucmp(&r, &P) >= 0) {
+        old_usub(&r, &r, &P);
+    }
+    set_bn(ret, &r);
+}
+
+static void old_subp(BN* ret, const BN* opa, const BN* opb)
+{
+    BN r;
+
+    if (old_usub(&r, opa, opb) == 1) {
+        old_uadd(&r, &r, &P);
+    }
+    set_bn(ret, &r);
+}
+
+// "old" 는 위의 분기 있는 사본, 바로 아래 줄이 arith_lib.c 의 지금 구현
+void bench_addsub()
+{
+    BN r;
+    volatile int32_t sink = 0;
+
+    BENCH_OP("uadd old", old_uadd(&r, a, b));
+    BENCH_OP("uadd", uadd(&r, a, b));
+    BENCH_OP("usub old", old_usub(&r, a, b));
+    BENCH_OP("usub", usub(&r, a, b));
+    BENCH_OP("ucmp old", sink += old_ucmp(a, b));
+    BENCH_OP("ucmp", sink += ucmp(a, b));
+    BENCH_OP("rshift1", rshift1(&r, a));
+    BENCH_OP("addp old", old_addp(a, a, b));
+    BENCH_OP("addp", addp(a, a, b));
+    BENCH_OP("subp old", old_subp(a, a, b));
+    BENCH_OP("subp", subp(a, a, b));
+    (void)sink;
+}
+
+/* ab - cd: 곱셈 두번 + subp 와 reduction 한번짜리 fused 커널 비교 (montgomery domain) */
+void bench_fused()
+{
+    BN t1, t2;
+
+    BENCH_OP("mul2+subp", (mulp_mont(&t1, a, b), mulp_mont(&t2, b, b), subp(a, &t1, &t2)));
+    BENCH_OP("mul_sub_mul", mulp_sub_mul_mont(a, a, b, b, b));
+}
+
+/* 256 x 256 --> 512 곱셈/제곱: schoolbook (operand / product scanning) vs Karatsuba */
+void bench_mul()
+{
+    BN2 t;
+
+    BENCH_OP("umul_os", umul_os(&t, a, b));
+    BENCH_OP("umul_ps", umul_ps(&t, a, b));
+    BENCH_OP("umul_kara1", umul_kara1(&t, a, b));
+    BENCH_OP("umul_kara2", umul_kara2(&t, a, b));
+    BENCH_OP("usqr_ps", usqr_ps(&t, a));
+    BENCH_OP("usqr_kara1", usqr_kara1(&t, a));
+    BENCH_OP("usqr_kara2", usqr_kara2(&t, a));
+}
+
+/* field_tmpl.h 로 만든 fp256 (모듈러스에서 계산한 상수, 일반 CIOS) vs arith_lib 의 P-256 전용 montgomery 곱셈 */
+void bench_field_tmpl()
+{
+    static fp256_fe fa[BENCH_SET], fb[BENCH_SET];
+
+    for (int i = 0; i < BENCH_SET; i++) {
+        memcpy(fa[i].v, in_a[i].v, sizeof(fa[i].v));
+        memcpy(fb[i].v, in_b[i].v, sizeof(fb[i].v));
+    }
+
+    BENCH_OP("mulp_mont", mulp_mont(a, a, b));
+    BENCH_OP("fp256_mul", fp256_mul(&fa[i], &fa[i], &fb[(i * 7 + 3) & (BENCH_SET - 1)]));
+}
+
+/* secp256k1 스칼라 곱셈: ecsm_ltr vs GLV (variable base / fixed base), 스칼라는 in_a 의 워드를 그대로 씀 */
+void bench_glv()
+{
+    k256_af r, q;
+
+    k256_ecsm_ltr(&q, &k256_g, in_b[0].v);
+
+    BENCH_OP_N("k256_ltr", BENCH_EC_N, k256_ecsm_ltr(&r, &q, a->v));
+    BENCH_OP_N("k256_glv", BENCH_EC_N, k256_ecsm_glv(&r, &q, a->v));
+    BENCH_OP_N("k256_ltr_G", BENCH_EC_N, k256_ecsm_ltr(&r, &k256_g, a->v));
+    BENCH_OP_N("k256_glv_G", BENCH_EC_N, k256_ecsm_glv_base(&r, a->v));
+}
+
+int main(void)
+{
+    for (int i = 0; i < BENCH_SET; i++) {
+        rnd_bn(&in_a[i]);
+        rnd_bn(&in_b[i]);
+    }
+
+    perf_open();
+    if (perf_fd < 0) printf("perf_event_open 사용 불가: 시간만 측정\n");
+
+    bench_addsub();
+    bench_fused();
+    bench_mul();
+    bench_field_tmpl();
+    bench_glv();
+
+    return 0;
+}
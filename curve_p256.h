@@ -0,0 +1,23 @@
+#ifndef CURVE_P256_H
+#define CURVE_P256_H
+
+/*  NIST P-256 (a = -3) 를 템플릿으로 만든 것: 필드 fp256_*, 점연산 p256_*
+    ECC_lib.c 의 P-256 전용 코드와 같은 결과를 내며, 다른 곡선과 같은 API 로 쓰거나 비교할 때 쓴다. */
+
+#include "field_p256.h"
+
+#define EC_PREFIX       p256
+#define EC_FIELD        fp256
+#define EC_WORDS        8
+#define EC_A_KIND       EC_A_MINUS3
+#define EC_B            {0x27d2604b, 0x3bce3c3e, 0xcc53b0f6, 0x651d06b0, \
+                         0x769886bc, 0xb3ebbd55, 0xaa3a93e7, 0x5ac635d8}
+#define EC_GX           {0xd898c296, 0xf4a13945, 0x2deb33a0, 0x77037d81, \
+                         0x63a440f2, 0xf8bce6e5, 0xe12c4247, 0x6b17d1f2}
+#define EC_GY           {0x37bf51f5, 0xcbb64068, 0x6b315ece, 0x2bce3357, \
+                         0x7c0f9e16, 0x8ee7eb4a, 0xfe1a7f9b, 0x4fe342e2}
+#define EC_ORDER        {0xfc632551, 0xf3b9cac2, 0xa7179e84, 0xbce6faad, \
+                         0xffffffff, 0xffffffff, 0x00000000, 0xffffffff}
+#include "ec_tmpl.h"
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef CURVE_P384_H
+#define CURVE_P384_H
+
+/*  NIST P-384: p = 2^384 - 2^128 - 2^96 + 2^32 - 1, a = -3
+    필드 fp384_*, 점연산 p384_* (워드 12개). p = -1 mod 2^32 이므로 montgomery 의 n0 = 1 로 상수 접기 된다. */
+
+#define FIELD_PREFIX    fp384
+#define FIELD_WORDS     12
+#define FIELD_MODULUS   {0xffffffff, 0x00000000, 0x00000000, 0xffffffff, \
+                         0xfffffffe, 0xffffffff, 0xffffffff, 0xffffffff, \
+                         0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}
+#include "field_tmpl.h"
+
+#define EC_PREFIX       p384
+#define EC_FIELD        fp384
+#define EC_WORDS        12
+#define EC_A_KIND       EC_A_MINUS3
+#define EC_B            {0xd3ec2aef, 0x2a85c8ed, 0x8a2ed19d, 0xc656398d, \
+                         0x5013875a, 0x0314088f, 0xfe814112, 0x181d9c6e, \
+                         0xe3f82d19, 0x988e056b, 0xe23ee7e4, 0xb3312fa7}
+#define EC_GX           {0x72760ab7, 0x3a545e38, 0xbf55296c, 0x5502f25d, \
+                         0x82542a38, 0x59f741e0, 0x8ba79b98, 0x6e1d3b62, \
+                         0xf320ad74, 0x8eb1c71e, 0xbe8b0537, 0xaa87ca22}
+#define EC_GY           {0x90ea0e5f, 0x7a431d7c, 0x1d7e819d, 0x0a60b1ce, \
+                         0xb5f0b8c0, 0xe9da3113, 0x289a147c, 0xf8f41dbd, \
+                         0x9292dc29, 0x5d9e98bf, 0x96262c6f, 0x3617de4a}
+#define EC_ORDER        {0xccc52973, 0xecec196a, 0x48b0a77a, 0x581a0db2, \
+                         0xf4372ddf, 0xc7634d81, 0xffffffff, 0xffffffff, \
+                         0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}
+#include "ec_tmpl.h"
+
+#endif
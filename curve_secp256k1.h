@@ -0,0 +1,27 @@
+#ifndef CURVE_SECP256K1_H
+#define CURVE_SECP256K1_H
+
+/*  secp256k1: p = 2^256 - 2^32 - 977, y^2 = x^3 + 7 (a = 0)
+    필드 fk256_*, 점연산 k256_* */
+
+#define FIELD_PREFIX    fk256
+#define FIELD_WORDS     8
+#define FIELD_MODULUS   {0xfffffc2f, 0xfffffffe, 0xffffffff, 0xffffffff, \
+                         0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}
+#include "field_tmpl.h"
+
+#define EC_PREFIX       k256
+#define EC_FIELD        fk256
+#define EC_WORDS        8
+#define EC_A_KIND       EC_A_ZERO
+#define EC_B            {0x00000007, 0x00000000, 0x00000000, 0x00000000, \
+                         0x00000000, 0x00000000, 0x00000000, 0x00000000}
+#define EC_GX           {0x16f81798, 0x59f2815b, 0x2dce28d9, 0x029bfcdb, \
+                         0xce870b07, 0x55a06295, 0xf9dcbbac, 0x79be667e}
+#define EC_GY           {0xfb10d4b8, 0x9c47d08f, 0xa6855419, 0xfd17b448, \
+                         0x0e1108a8, 0x5da4fbfc, 0x26a3c465, 0x483ada77}
+#define EC_ORDER        {0xd0364141, 0xbfd25e8c, 0xaf48a03b, 0xbaaedce6, \
+                         0xfffffffe, 0xffffffff, 0xffffffff, 0xffffffff}
+#include "ec_tmpl.h"
+
+#endif
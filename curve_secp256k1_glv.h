@@ -0,0 +1,237 @@
+#ifndef CURVE_SECP256K1_GLV_H
+#define CURVE_SECP256K1_GLV_H
+
+/*  secp256k1 GLV 스칼라 곱셈
+    secp256k1 에는 lambda^3 = 1 (mod n), beta^3 = 1 (mod p) 인 자기준동형 lambda (x, y) = (beta x, y) 가 있다.
+    k = k1 + k2 lambda (mod n), |k1|, |k2| < 2^128 로 나누면
+        k P = k1 P + k2 (lambda P)
+    이므로 128비트 스칼라 두개의 동시 곱셈 (Shamir) 으로 계산하고 더블링이 256번 --> 128번으로 준다.
+
+    k256_glv_split      : 스칼라 분해 (libsecp256k1 와 같은 방법: c_i = round(k g_i / 2^384), 반올림 상수 g_i 미리 계산)
+    k256_ecsm_glv       : 임의의 점 (variable base)
+    k256_ecsm_glv_base  : 생성원 G (fixed base), 미리 계산한 표로 2비트씩 동시 처리
+
+    variable base 에서 P1 + P2 를 affine 으로 만들려면 역원이 필요한데, a = 0 인 곡선의 더블링/덧셈 공식은 b 와 무관하므로
+    P1 + P2 = (X, Y, Z) 일 때 모든 점을 (x Z^2, y Z^3) 로 옮긴 동형 곡선 y^2 = x^3 + b Z^6 위에서 계산하고 마지막에 Z 를 곱한다.
+    ecsm_ltr 처럼 상수 시간은 아니다 (서명 검증 같은 공개 스칼라용).  */
+
+#include "curve_secp256k1.h"
+
+// 스칼라 (mod n) 연산은 같은 템플릿으로 만든 nk256_* 을 쓴다
+#define FIELD_PREFIX    nk256
+#define FIELD_WORDS     8
+#define FIELD_MODULUS   {0xd0364141, 0xbfd25e8c, 0xaf48a03b, 0xbaaedce6, \
+                         0xfffffffe, 0xffffffff, 0xffffffff, 0xffffffff}
+#include "field_tmpl.h"
+
+static const fk256_fe k256_beta = {{0x719501ee, 0xc1396c28, 0x12f58995, 0x9cf04975,
+                                    0xac3434e9, 0x6e64479e, 0x657c0710, 0x7ae96a2b}};
+static fk256_fe k256_beta_m;              // montgomery domain, k256_glv_init 에서 계산
+static const nk256_fe k256_lambda = {{0x1b23bd72, 0xdf02967c, 0x20816678, 0x122e22ea,
+                                      0x8812645a, 0xa5261c02, 0xc05c30e0, 0x5363ad4c}};
+
+// 격자 기저 (a1, b1), (a2, b2) 에서 -b1, -b2 (mod n) 와 g1 = round(2^384 b2 / n), g2 = round(2^384 (-b1) / n)
+static const nk256_fe k256_minus_b1 = {{0x0abfe4c3, 0x6f547fa9, 0x010e8828, 0xe4437ed6,
+                                        0x00000000, 0x00000000, 0x00000000, 0x00000000}};
+static const nk256_fe k256_minus_b2 = {{0x3db1562c, 0xd765cda8, 0x0774346d, 0x8a280ac5,
+                                        0xfffffffe, 0xffffffff, 0xffffffff, 0xffffffff}};
+static const uint32_t k256_g1[8] = {0x45dbb031, 0xe893209a, 0x71e8ca7f, 0x3daa8a14,
+                                    0x9284eb15, 0xe86c90e4, 0xa7d46bcd, 0x3086d221};
+static const uint32_t k256_g2[8] = {0x8ac47f71, 0x1571b4ae, 0x9df506c6, 0x221208ac,
+                                    0x0abfe4c4, 0x6f547fa9, 0x010e8828, 0xe4437ed6};
+
+/* r = round(k g / 2^384), 결과는 129비트 이하 */
+static inline void k256_mul_shift384(nk256_fe* r, const uint32_t k[8], const uint32_t g[8])
+{
+    uint32_t t[16] = {0}, c = 0;
+    uint64_t uv = 0;
+
+    for (int i = 0; i < 8; i++) {
+        c = 0;
+        for (int j = 0; j < 8; j++) {
+            uv = (uint64_t)k[j] * g[i] + t[i + j] + c;
+            t[i + j] = (uint32_t)uv;
+            c = (uint32_t)(uv >> 32);
+        }
+        t[i + 8] = c;
+    }
+
+    c = t[11] >> 31;
+    for (int i = 0; i < 4; i++) {
+        uv = (uint64_t)t[12 + i] + c;
+        r->v[i] = (uint32_t)uv;
+        c = (uint32_t)(uv >> 32);
+    }
+    r->v[4] = c;
+    r->v[5] = r->v[6] = r->v[7] = 0;
+}
+
+/* n 의 절반보다 크면 n - r 로 바꾸고 1 리턴, 분해 결과는 둘 중 하나가 128비트 이하 */
+static inline int k256_glv_abs(nk256_fe* r)
+{
+    if ((r->v[4] | r->v[5] | r->v[6] | r->v[7]) == 0) return 0;
+    nk256_neg(r, r);
+    return 1;
+}
+
+/*  k = (-1)^neg1 k1 + (-1)^neg2 k2 lambda (mod n), k1, k2 < 2^128 (k1, k2 는 하위 4워드만 씀)
+    k 는 n 이상이어도 된다  */
+static inline void k256_glv_split(uint32_t k1[4], int* neg1, uint32_t k2[4], int* neg2, const uint32_t k[8])
+{
+    nk256_fe kk, c1, c2, r1, r2;
+
+    memcpy(kk.v, k, sizeof(kk.v));
+    nk256_reduce_once(&kk, &kk, 0);
+
+    // r2 = c1 (-b1) + c2 (-b2), r1 = k - r2 lambda: 한쪽을 montgomery domain 에 넣으면 곱셈 결과는 normal domain
+    k256_mul_shift384(&c1, kk.v, k256_g1);
+    k256_mul_shift384(&c2, kk.v, k256_g2);
+    nk256_to_mont(&c1, &c1);
+    nk256_to_mont(&c2, &c2);
+    nk256_mul(&c1, &c1, &k256_minus_b1);
+    nk256_mul(&c2, &c2, &k256_minus_b2);
+    nk256_add(&r2, &c1, &c2);
+
+    nk256_to_mont(&r1, &r2);
+    nk256_mul(&r1, &r1, &k256_lambda);
+    nk256_sub(&r1, &kk, &r1);
+
+    *neg1 = k256_glv_abs(&r1);
+    *neg2 = k256_glv_abs(&r2);
+    memcpy(k1, r1.v, 4 * sizeof(uint32_t));
+    memcpy(k2, r2.v, 4 * sizeof(uint32_t));
+}
+
+/* r = k p, variable base. P1 = +-P, P2 = +-lambda P, P1 + P2 를 동형 곡선의 affine 점으로 두고 128비트 Shamir */
+static inline void k256_ecsm_glv(k256_af* r, const k256_af* p, const uint32_t k[8])
+{
+    uint32_t k1[4], k2[4];
+    int neg1 = 0, neg2 = 0;
+    k256_af q[3];
+    k256_jc s, acc;
+    fk256_fe zz, zzz;
+
+    if (p->is_infty) {
+        memset(r, 0, sizeof(*r));
+        r->is_infty = 1;
+        return;
+    }
+
+    k256_glv_split(k1, &neg1, k2, &neg2, k);
+
+    // q[0] = P1, q[1] = P2 (montgomery domain)
+    fk256_to_mont(&q[0].x, &p->x);
+    fk256_to_mont(&q[0].y, &p->y);
+    fk256_mul(&q[1].x, &q[0].x, &k256_beta_m);
+    q[1].y = q[0].y;
+    if (neg1) fk256_neg(&q[0].y, &q[0].y);
+    if (neg2) fk256_neg(&q[1].y, &q[1].y);
+    q[0].is_infty = q[1].is_infty = 0;
+
+    // s = P1 + P2 (jacobian), lambda 는 +-1 이 아니므로 P1 != +-P2
+    s.x = q[0].x;
+    s.y = q[0].y;
+    s.z = fk256_one;
+    s.is_infty = 0;
+    k256_ecadd_jc(&s, &s, &q[1]);
+
+    // 동형 곡선으로: (x, y) --> (x Z^2, y Z^3), q[2] = (X, Y)
+    fk256_sqr(&zz, &s.z);
+    fk256_mul(&zzz, &zz, &s.z);
+    for (int i = 0; i < 2; i++) {
+        fk256_mul(&q[i].x, &q[i].x, &zz);
+        fk256_mul(&q[i].y, &q[i].y, &zzz);
+    }
+    q[2].x = s.x;
+    q[2].y = s.y;
+    q[2].is_infty = 0;
+
+    memset(&acc, 0, sizeof(acc));
+    acc.is_infty = 1;
+    for (int i = 3; i >= 0; i--) {
+        for (int j = 31; j >= 0; j--) {
+            int idx = ((k1[i] >> j) & 1) | (((k2[i] >> j) & 1) << 1);
+
+            k256_ecdbl_jc(&acc, &acc);
+            if (idx) k256_ecadd_jc(&acc, &acc, &q[idx - 1]);
+        }
+    }
+
+    // 원래 곡선으로: Z <-- Z Z_s
+    if (!acc.is_infty) fk256_mul(&acc.z, &acc.z, &s.z);
+    k256_jc2af(r, &acc);
+}
+
+/*  fixed base 표: i G + j (lambda G), 0 <= i, j < 4 (montgomery domain affine)
+    k256_glv_tbl[0] 은 +lambda G, [1] 은 -lambda G. 인덱스 i + 4j, [0][0] 은 무한원점  */
+static k256_af k256_glv_tbl[2][16];
+
+static void k256_glv_init(void)
+{
+    k256_af g, lg;
+    k256_jc t;
+
+    fk256_init();
+    nk256_init();
+    fk256_to_mont(&k256_beta_m, &k256_beta);
+
+    fk256_to_mont(&g.x, &k256_g.x);
+    fk256_to_mont(&g.y, &k256_g.y);
+    g.is_infty = 0;
+
+    for (int s = 0; s < 2; s++) {
+        lg = g;
+        fk256_mul(&lg.x, &g.x, &k256_beta_m);
+        if (s) fk256_neg(&lg.y, &lg.y);
+
+        memset(&t, 0, sizeof(t));
+        t.is_infty = 1;
+        for (int j = 0; j < 4; j++) {
+            k256_jc u = t;
+
+            for (int i = 0; i < 4; i++) {
+                // jc2af 는 normal domain 으로 빠져나오므로 다시 넣는다
+                k256_jc2af(&k256_glv_tbl[s][i + 4 * j], &u);
+                fk256_to_mont(&k256_glv_tbl[s][i + 4 * j].x, &k256_glv_tbl[s][i + 4 * j].x);
+                fk256_to_mont(&k256_glv_tbl[s][i + 4 * j].y, &k256_glv_tbl[s][i + 4 * j].y);
+                k256_ecadd_jc(&u, &u, &g);
+            }
+            k256_ecadd_jc(&t, &t, &lg);
+        }
+    }
+}
+
+FIELD_CTOR static void k256_glv_init_ctor(void)
+{
+    k256_glv_init();
+}
+
+/*  r = k G, fixed base. k1, k2 를 2비트씩 같이 읽어 (64번 반복) 표 한번 더하기
+    neg1 == neg2 이면 +lambda 표, 다르면 -lambda 표를 쓰고 neg1 이면 결과 점의 y 부호를 바꾼다  */
+static inline void k256_ecsm_glv_base(k256_af* r, const uint32_t k[8])
+{
+    uint32_t k1[4], k2[4];
+    int neg1 = 0, neg2 = 0;
+    const k256_af* tbl = 0;
+    k256_jc acc;
+
+    k256_glv_split(k1, &neg1, k2, &neg2, k);
+    tbl = k256_glv_tbl[neg1 ^ neg2];
+
+    memset(&acc, 0, sizeof(acc));
+    acc.is_infty = 1;
+    for (int i = 3; i >= 0; i--) {
+        for (int j = 30; j >= 0; j -= 2) {
+            int idx = ((k1[i] >> j) & 3) | (((k2[i] >> j) & 3) << 2);
+
+            k256_ecdbl_jc(&acc, &acc);
+            k256_ecdbl_jc(&acc, &acc);
+            if (idx) k256_ecadd_jc(&acc, &acc, &tbl[idx]);
+        }
+    }
+
+    if (neg1) fk256_neg(&acc.y, &acc.y);
+    k256_jc2af(r, &acc);
+}
+
+#endif
@@ -0,0 +1,240 @@
+/*  ec_tmpl.h : field_tmpl.h 로 만든 필드 위에 y^2 = x^3 + ax + b 곡선의 점연산을 만들어주는 템플릿 헤더
+    (include guard 없음: 곡선마다 파라미터를 바꿔 include 한다)
+
+    사용법: 먼저 field_tmpl.h 로 EC_FIELD 필드를 만든 후
+        #define EC_PREFIX       p384            // 함수/타입 이름 앞에 붙음
+        #define EC_FIELD        fp384           // field_tmpl.h 의 FIELD_PREFIX
+        #define EC_WORDS        12              // 32비트 워드 개수 (필드와 스칼라 공통)
+        #define EC_A_KIND       EC_A_MINUS3     // EC_A_MINUS3 (a = -3) 또는 EC_A_ZERO (a = 0)
+        #define EC_B            {...}           // b, 하위 워드부터 (normal domain)
+        #define EC_GX           {...}           // 생성원 G
+        #define EC_GY           {...}
+        #define EC_ORDER        {...}           // 군의 위수 n
+        #include "ec_tmpl.h"
+
+    만들어지는 것 (PREFIX = EC_PREFIX):
+        PREFIX_af, PREFIX_jc            : affine / jacobian 점 (affine 은 normal domain, jacobian 은 montgomery domain)
+        PREFIX_g, PREFIX_n, PREFIX_b    : 생성원, 위수, b
+        PREFIX_ecdbl_jc, PREFIX_ecadd_jc: jacobian 더블링, jacobian + affine (ECC_lib.c 와 같은 공식)
+        PREFIX_af2jc, PREFIX_jc2af      : 좌표 변환 (domain 변환 포함)
+        PREFIX_ecsm_ltr                 : left to right 스칼라 곱셈, 스칼라는 uint32_t k[EC_WORDS]
+        PREFIX_on_curve                 : 곡선 위의 점인지 확인
+
+    a 의 종류는 컴파일할 때 고른다 (#if): a = -3 이면 3(X - Z^2)(X + Z^2), a = 0 이면 3X^2. 실행 중 분기는 없다.  */
+
+#if !defined(EC_PREFIX) || !defined(EC_FIELD) || !defined(EC_WORDS) || !defined(EC_A_KIND) || \
+    !defined(EC_B) || !defined(EC_GX) || !defined(EC_GY) || !defined(EC_ORDER)
+#error "ec_tmpl.h: EC_PREFIX, EC_FIELD, EC_WORDS, EC_A_KIND, EC_B, EC_GX, EC_GY, EC_ORDER 를 먼저 정의해야 함"
+#endif
+
+#ifndef EC_TMPL_COMMON
+#define EC_TMPL_COMMON
+#include <string.h>
+#define EC_A_MINUS3     1
+#define EC_A_ZERO       2
+#endif
+
+#define EN(name)    FIELD_CAT(EC_PREFIX, name)
+#define FF(name)    FIELD_CAT(EC_FIELD, name)
+#define FE          FF(fe)
+
+typedef struct {
+    FE x, y;
+    uint32_t is_infty;
+} EN(af);
+
+typedef struct {
+    FE x, y, z;
+    uint32_t is_infty;
+} EN(jc);
+
+static const EN(af) EN(g) = {{EC_GX}, {EC_GY}, 0};
+static const FE EN(b) = {EC_B};
+static const uint32_t EN(n)[EC_WORDS] = EC_ORDER;
+
+/* affine (normal domain) --> jacobian (montgomery domain), Z = 1 */
+static inline void EN(af2jc)(EN(jc)* r, const EN(af)* p)
+{
+    FF(to_mont)(&r->x, &p->x);
+    FF(to_mont)(&r->y, &p->y);
+    r->z = FF(one);
+    r->is_infty = p->is_infty;
+}
+
+/* jacobian --> affine: (X/Z^2, Y/Z^3), domain 에서 빠져나옴 */
+static inline void EN(jc2af)(EN(af)* r, const EN(jc)* p)
+{
+    FE zi, zi2;
+
+    if (p->is_infty) {
+        memset(r, 0, sizeof(*r));
+        r->is_infty = 1;
+        return;
+    }
+
+    FF(inv)(&zi, &p->z);
+    FF(sqr)(&zi2, &zi);
+    FF(mul)(&r->x, &p->x, &zi2);
+    FF(mul)(&zi2, &zi2, &zi);
+    FF(mul)(&r->y, &p->y, &zi2);
+    FF(from_mont)(&r->x, &r->x);
+    FF(from_mont)(&r->y, &r->y);
+    r->is_infty = 0;
+}
+
+/* doubling over jacobian: M = 3(X - Z^2)(X + Z^2) (a = -3) 또는 3X^2 (a = 0), S = 4XY^2
+   X3 = M^2 - 2S, Y3 = M(S - X3) - 8Y^4, Z3 = 2YZ */
+static inline void EN(ecdbl_jc)(EN(jc)* r, const EN(jc)* p)
+{
+    FE t1, t2, t3, rx, ry, rz;
+
+    if (p->is_infty) {
+        r->is_infty = 1;
+        return;
+    }
+
+#if EC_A_KIND == EC_A_MINUS3
+    FF(sqr)(&t1, &p->z);
+    FF(sub)(&t2, &p->x, &t1);
+    FF(add)(&t1, &p->x, &t1);
+    FF(mul)(&t2, &t2, &t1);
+#elif EC_A_KIND == EC_A_ZERO
+    FF(sqr)(&t2, &p->x);
+#else
+#error "ec_tmpl.h: EC_A_KIND 는 EC_A_MINUS3 또는 EC_A_ZERO"
+#endif
+    FF(add)(&t3, &t2, &t2);
+    FF(add)(&t2, &t2, &t3);             // M
+    FF(add)(&ry, &p->y, &p->y);
+    FF(mul)(&rz, &ry, &p->z);
+    FF(sqr)(&ry, &ry);
+    FF(mul)(&t3, &ry, &p->x);           // S
+    FF(sqr)(&ry, &ry);
+    FF(half)(&ry, &ry);                 // 8Y^4
+
+    FF(sqr)(&rx, &t2);
+    FF(add)(&t1, &t3, &t3);
+    FF(sub)(&rx, &rx, &t1);
+    FF(sub)(&t1, &t3, &rx);
+    FF(mul)(&t1, &t1, &t2);
+    FF(sub)(&ry, &t1, &ry);
+
+    r->x = rx;
+    r->y = ry;
+    r->z = rz;
+    r->is_infty = 0;
+}
+
+/* addition over jacobian, jacobian + affine. q 는 montgomery domain 의 affine 좌표 */
+static inline void EN(ecadd_jc)(EN(jc)* r, const EN(jc)* p, const EN(af)* q)
+{
+    FE t1, t2, t3, t4, rx, ry, rz;
+
+    if (p->is_infty) {
+        r->x = q->x;
+        r->y = q->y;
+        r->z = FF(one);
+        r->is_infty = q->is_infty;
+        return;
+    } else if (q->is_infty) {
+        *r = *p;
+        return;
+    }
+
+    FF(sqr)(&t1, &p->z);
+    FF(mul)(&t2, &t1, &p->z);
+    FF(mul)(&t1, &t1, &q->x);
+    FF(mul)(&t2, &t2, &q->y);
+    FF(sub)(&t1, &t1, &p->x);
+    FF(sub)(&t2, &t2, &p->y);
+
+    if (FF(is_zero)(&t1)) {
+        if (FF(is_zero)(&t2)) {
+            // P = Q
+            r->x = q->x;
+            r->y = q->y;
+            r->z = FF(one);
+            r->is_infty = 0;
+            EN(ecdbl_jc)(r, r);
+        } else {
+            // P = -Q
+            r->is_infty = 1;
+        }
+        return;
+    }
+
+    FF(mul)(&rz, &p->z, &t1);
+    FF(sqr)(&t3, &t1);
+    FF(mul)(&t4, &t3, &t1);
+    FF(mul)(&t3, &t3, &p->x);
+    FF(add)(&t1, &t3, &t3);
+    FF(sqr)(&rx, &t2);
+    FF(sub)(&rx, &rx, &t1);
+    FF(sub)(&rx, &rx, &t4);
+    FF(sub)(&t3, &t3, &rx);
+    FF(mul)(&t3, &t3, &t2);
+    FF(mul)(&t4, &t4, &p->y);
+    FF(sub)(&ry, &t3, &t4);
+
+    r->x = rx;
+    r->y = ry;
+    r->z = rz;
+    r->is_infty = 0;
+}
+
+/* scalar multiplication, left to right: r = k p (affine, normal domain) */
+static inline void EN(ecsm_ltr)(EN(af)* r, const EN(af)* p, const uint32_t k[EC_WORDS])
+{
+    EN(af) pm;
+    EN(jc) acc;
+
+    FF(to_mont)(&pm.x, &p->x);
+    FF(to_mont)(&pm.y, &p->y);
+    pm.is_infty = p->is_infty;
+    memset(&acc, 0, sizeof(acc));
+    acc.is_infty = 1;
+
+    for (int i = EC_WORDS - 1; i >= 0; i--) {
+        for (int j = 31; j >= 0; j--) {
+            EN(ecdbl_jc)(&acc, &acc);
+            if ((k[i] >> j) & 1) EN(ecadd_jc)(&acc, &acc, &pm);
+        }
+    }
+
+    EN(jc2af)(r, &acc);
+}
+
+/* y^2 = x^3 + ax + b 인지 확인 (affine, normal domain), 무한원점은 1 */
+static inline uint32_t EN(on_curve)(const EN(af)* p)
+{
+    FE x, y, l, rh, t;
+
+    if (p->is_infty) return 1;
+
+    FF(to_mont)(&x, &p->x);
+    FF(to_mont)(&y, &p->y);
+    FF(sqr)(&l, &y);
+    FF(sqr)(&rh, &x);
+    FF(mul)(&rh, &rh, &x);
+#if EC_A_KIND == EC_A_MINUS3
+    FF(add)(&t, &x, &x);
+    FF(add)(&t, &t, &x);
+    FF(sub)(&rh, &rh, &t);
+#endif
+    FF(to_mont)(&t, &EN(b));
+    FF(add)(&rh, &rh, &t);
+
+    return FF(eq)(&l, &rh);
+}
+
+#undef EN
+#undef FF
+#undef FE
+#undef EC_PREFIX
+#undef EC_FIELD
+#undef EC_WORDS
+#undef EC_A_KIND
+#undef EC_B
+#undef EC_GX
+#undef EC_GY
+#undef EC_ORDER
@@ -0,0 +1,12 @@
+#ifndef FIELD_P256_H
+#define FIELD_P256_H
+
+/*  P-256 필드 (p = 2^256 - 2^224 + 2^192 + 2^96 - 1) 를 field_tmpl.h 로 만든 것: fp256_*
+    arith_lib.c 의 손으로 적은 상수 (RmodP, RRmodP, P_prime) 와 같은 값이 모듈러스에서 계산된다. */
+#define FIELD_PREFIX    fp256
+#define FIELD_WORDS     8
+#define FIELD_MODULUS   {0xffffffff, 0xffffffff, 0xffffffff, 0x00000000, \
+                         0x00000000, 0x00000000, 0x00000001, 0xffffffff}
+#include "field_tmpl.h"
+
+#endif
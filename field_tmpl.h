@@ -0,0 +1,255 @@
+/*  field_tmpl.h : 모듈러스만 주면 그 필드의 montgomery 연산을 만들어주는 템플릿 헤더
+    (include guard 없음: 파라미터를 바꿔가며 여러번 include 한다)
+
+    사용법:
+        #define FIELD_PREFIX    fp256           // 함수/타입 이름 앞에 붙음
+        #define FIELD_WORDS     8               // 32비트 워드 개수
+        #define FIELD_MODULUS   {0xffffffff, 0xffffffff, ...}   // p, 하위 워드부터
+        #include "field_tmpl.h"
+
+    만들어지는 것 (PREFIX = FIELD_PREFIX):
+        PREFIX_fe                       : 원소 타입 { uint32_t v[FIELD_WORDS]; }
+        PREFIX_p                        : 모듈러스
+        PREFIX_one, PREFIX_rr           : R mod p (montgomery domain의 1), R^2 mod p   (R = 2^{32 * FIELD_WORDS})
+        PREFIX_add, _sub, _neg, _half   : mod p 덧셈/뺄셈/부호반전/반으로 나누기 (domain 과 무관)
+        PREFIX_mul, _sqr                : montgomery 곱셈/제곱 (CIOS)
+        PREFIX_to_mont, _from_mont      : domain 변환
+        PREFIX_inv                      : domain 안에서 a^{p-2}
+        PREFIX_cmov, _is_zero, _eq
+
+    n0 = -p^{-1} mod 2^32 는 p의 최하위 워드에서 뉴턴 반복으로 구하는 상수식이라 컴파일할 때 계산된다.
+    R mod p, R^2 mod p 는 p 에서 시작해서 2배씩 해서 구한다. C 에는 constexpr 이 없으므로
+    GCC/clang 에서는 프로그램 시작 시 (constructor) 한번 계산하고, 그 외 컴파일러에서는 PREFIX_init() 을 먼저 부른다.
+    (1/2 mod p 같은 상수 대신 PREFIX_half 를 쓴다.)
+
+    연산은 전부 static inline (GCC/clang 에서는 always_inline) 이고, 반복 횟수가 FIELD_WORDS 상수이므로
+    컴파일러가 풀어서 p의 0 / 0xffffffff 워드 곱셈까지 상수 접기 한다.
+    입력은 [0, p) 로 가정하고 출력도 [0, p). 분기는 p (공개값) 에만 의존한다.  */
+
+#if !defined(FIELD_PREFIX) || !defined(FIELD_WORDS) || !defined(FIELD_MODULUS)
+#error "field_tmpl.h: FIELD_PREFIX, FIELD_WORDS, FIELD_MODULUS 를 먼저 정의해야 함"
+#endif
+
+#ifndef FIELD_TMPL_COMMON
+#define FIELD_TMPL_COMMON
+
+#include <stdint.h>
+
+#define FIELD_CAT_(a, b)    a##_##b
+#define FIELD_CAT(a, b)     FIELD_CAT_(a, b)
+
+#if defined(__GNUC__) || defined(__clang__)
+#define FIELD_INLINE        static inline __attribute__((always_inline))
+#define FIELD_CTOR          __attribute__((constructor))
+#else
+#define FIELD_INLINE        static inline
+#define FIELD_CTOR
+#endif
+
+// x <-- x (2 - p x) : 맞는 비트 수가 두배가 됨, 홀수 p 에 대해 x = p 이면 3비트가 맞으므로 4번이면 32비트
+#define FIELD_NEWTON(p, x)  ((uint32_t)((x) * (2u - (uint32_t)(p) * (x))))
+#define FIELD_N0(p)         ((uint32_t)(0u - FIELD_NEWTON(p, FIELD_NEWTON(p, FIELD_NEWTON(p, FIELD_NEWTON(p, (uint32_t)(p)))))))
+
+#endif
+
+#define FN(name)    FIELD_CAT(FIELD_PREFIX, name)
+#define FW          FIELD_WORDS
+
+typedef struct {
+    uint32_t v[FW];
+} FN(fe);
+
+static const FN(fe) FN(p) = {FIELD_MODULUS};
+static FN(fe) FN(one);
+static FN(fe) FN(rr);
+
+/* r = a + b, 캐리 리턴 */
+FIELD_INLINE uint32_t FN(add_raw)(FN(fe)* r, const FN(fe)* a, const FN(fe)* b)
+{
+    uint64_t t = 0;
+    uint32_t c = 0;
+
+    for (int i = 0; i < FW; i++) {
+        t = (uint64_t)a->v[i] + b->v[i] + c;
+        r->v[i] = (uint32_t)t;
+        c = (uint32_t)(t >> 32);
+    }
+    return c;
+}
+
+/* r = a - b, 빌림 리턴 */
+FIELD_INLINE uint32_t FN(sub_raw)(FN(fe)* r, const FN(fe)* a, const FN(fe)* b)
+{
+    uint64_t t = 0;
+    uint32_t c = 0;
+
+    for (int i = 0; i < FW; i++) {
+        t = (uint64_t)a->v[i] - b->v[i] - c;
+        r->v[i] = (uint32_t)t;
+        c = (uint32_t)(t >> 32) & 1;
+    }
+    return c;
+}
+
+/* mask 가 전부 1 이면 r = a */
+FIELD_INLINE void FN(cmov)(FN(fe)* r, const FN(fe)* a, uint32_t mask)
+{
+    for (int i = 0; i < FW; i++) {
+        r->v[i] ^= (r->v[i] ^ a->v[i]) & mask;
+    }
+}
+
+FIELD_INLINE uint32_t FN(is_zero)(const FN(fe)* a)
+{
+    uint32_t t = 0;
+
+    for (int i = 0; i < FW; i++) t |= a->v[i];
+    return (uint32_t)(((uint64_t)t - 1) >> 63);     // 0 이면 1
+}
+
+FIELD_INLINE uint32_t FN(eq)(const FN(fe)* a, const FN(fe)* b)
+{
+    uint32_t t = 0;
+
+    for (int i = 0; i < FW; i++) t |= a->v[i] ^ b->v[i];
+    return (uint32_t)(((uint64_t)t - 1) >> 63);
+}
+
+/* c || a 가 p 이상이면 p 를 뺌 (c || a < 2p) */
+FIELD_INLINE void FN(reduce_once)(FN(fe)* r, const FN(fe)* a, uint32_t c)
+{
+    FN(fe) s;
+    uint32_t borrow = FN(sub_raw)(&s, a, &FN(p));
+
+    *r = *a;
+    FN(cmov)(r, &s, 0 - (c | (borrow ^ 1)));
+}
+
+FIELD_INLINE void FN(add)(FN(fe)* r, const FN(fe)* a, const FN(fe)* b)
+{
+    FN(fe) t;
+    uint32_t c = FN(add_raw)(&t, a, b);
+
+    FN(reduce_once)(r, &t, c);
+}
+
+FIELD_INLINE void FN(sub)(FN(fe)* r, const FN(fe)* a, const FN(fe)* b)
+{
+    FN(fe) t, pm;
+    uint32_t mask = 0 - FN(sub_raw)(&t, a, b);
+
+    for (int i = 0; i < FW; i++) pm.v[i] = FN(p).v[i] & mask;
+    FN(add_raw)(r, &t, &pm);
+}
+
+FIELD_INLINE void FN(neg)(FN(fe)* r, const FN(fe)* a)
+{
+    FN(fe) z = {{0}};
+
+    FN(sub)(r, &z, a);
+}
+
+/* r = a / 2 mod p : 홀수이면 p 를 더한 후 (캐리 포함) 오른쪽으로 한 비트 */
+FIELD_INLINE void FN(half)(FN(fe)* r, const FN(fe)* a)
+{
+    FN(fe) t, pm;
+    uint32_t mask = 0 - (a->v[0] & 1), c = 0;
+
+    for (int i = 0; i < FW; i++) pm.v[i] = FN(p).v[i] & mask;
+    c = FN(add_raw)(&t, a, &pm);
+    for (int i = 0; i < FW - 1; i++) {
+        r->v[i] = (t.v[i] >> 1) | (t.v[i + 1] << 31);
+    }
+    r->v[FW - 1] = (t.v[FW - 1] >> 1) | (c << 31);
+}
+
+/*  montgomery 곱셈 (CIOS): 워드마다 a * b_i 를 더하고 m = t_0 n0 로 m p 를 더한 후 한 워드 내림
+    t 는 FW + 2 워드, 결과 t < 2p 이므로 마지막에 p 를 한번 뺀다.  */
+FIELD_INLINE void FN(mul)(FN(fe)* r, const FN(fe)* a, const FN(fe)* b)
+{
+    const uint32_t n0 = FIELD_N0(FN(p).v[0]);
+    uint32_t t[FW + 2] = {0};
+    uint32_t m = 0, c = 0;
+    uint64_t uv = 0;
+    FN(fe) res;
+
+    for (int i = 0; i < FW; i++) {
+        c = 0;
+        for (int j = 0; j < FW; j++) {
+            uv = (uint64_t)a->v[j] * b->v[i] + t[j] + c;
+            t[j] = (uint32_t)uv;
+            c = (uint32_t)(uv >> 32);
+        }
+        uv = (uint64_t)t[FW] + c;
+        t[FW] = (uint32_t)uv;
+        t[FW + 1] = (uint32_t)(uv >> 32);
+
+        m = t[0] * n0;
+        uv = (uint64_t)m * FN(p).v[0] + t[0];
+        c = (uint32_t)(uv >> 32);
+        for (int j = 1; j < FW; j++) {
+            uv = (uint64_t)m * FN(p).v[j] + t[j] + c;
+            t[j - 1] = (uint32_t)uv;
+            c = (uint32_t)(uv >> 32);
+        }
+        uv = (uint64_t)t[FW] + c;
+        t[FW - 1] = (uint32_t)uv;
+        t[FW] = t[FW + 1] + (uint32_t)(uv >> 32);
+    }
+
+    for (int i = 0; i < FW; i++) res.v[i] = t[i];
+    FN(reduce_once)(r, &res, t[FW]);
+}
+
+FIELD_INLINE void FN(sqr)(FN(fe)* r, const FN(fe)* a)
+{
+    FN(mul)(r, a, a);
+}
+
+FIELD_INLINE void FN(to_mont)(FN(fe)* r, const FN(fe)* a)
+{
+    FN(mul)(r, a, &FN(rr));
+}
+
+FIELD_INLINE void FN(from_mont)(FN(fe)* r, const FN(fe)* a)
+{
+    FN(fe) o = {{1}};
+
+    FN(mul)(r, a, &o);
+}
+
+/*  a^{p-2}, domain 안에서 계산. 지수 p-2 는 공개값이므로 비트에 따라 분기해도 된다. (a = 0 이면 0) */
+static inline void FN(inv)(FN(fe)* r, const FN(fe)* a)
+{
+    FN(fe) e, two = {{2}}, x = FN(one);
+
+    FN(sub_raw)(&e, &FN(p), &two);
+    for (int i = 32 * FW - 1; i >= 0; i--) {
+        FN(sqr)(&x, &x);
+        if ((e.v[i / 32] >> (i % 32)) & 1) FN(mul)(&x, &x, a);
+    }
+    *r = x;
+}
+
+/*  R mod p, R^2 mod p: 1 에서 시작해서 mod p 로 2배를 32 FW 번 / 64 FW 번  */
+static void FN(init)(void)
+{
+    FN(fe) x = {{1}};
+
+    for (int i = 0; i < 64 * FW; i++) {
+        FN(add)(&x, &x, &x);
+        if (i == 32 * FW - 1) FN(one) = x;
+    }
+    FN(rr) = x;
+}
+
+FIELD_CTOR static void FN(init_ctor)(void)
+{
+    FN(init)();
+}
+
+#undef FN
+#undef FW
+#undef FIELD_PREFIX
+#undef FIELD_WORDS
+#undef FIELD_MODULUS
@@ -1,4 +1,79 @@
 #include "arith_lib.h"
+#include "arith_x8.h"
+#include "field_p256.h"
+#include "ECC_lib.h"
+#include "curve_p384.h"
+#include "curve_secp256k1.h"
+#include "curve_secp256k1_glv.h"
+
+/*  ECC_lib.c 까지 같이 링크한다.
+    gcc -DECC_LIB_NO_MAIN test.c ECC_lib.c arith_lib.c arith_x8.c */
+
+// P-256 의 위수 n 위의 필드 (mod n 역원 비교용): np256_*
+#define FIELD_PREFIX    np256
+#define FIELD_WORDS     8
+#define FIELD_MODULUS   {0xfc632551, 0xf3b9cac2, 0xa7179e84, 0xbce6faad, \
+                         0xffffffff, 0xffffffff, 0x00000000, 0xffffffff}
+#include "field_tmpl.h"
+
+/*  벡터 파일 없이 다른 구현과 비교하는 테스트들이 쓰는 난수 (xorshift, 시드 고정)
+    결과는 "이름: 틀린 개수 / 전체" 로 출력한다. */
+#define TEST_N 256
+
+static uint64_t test_rnd = 0x2545f4914f6cdd1dULL;
+
+static uint32_t rnd32(void)
+{
+    test_rnd ^= test_rnd << 13;
+    test_rnd ^= test_rnd >> 7;
+    test_rnd ^= test_rnd << 17;
+    return (uint32_t)(test_rnd >> 16);
+}
+
+// [0, m) 의 난수
+static void rnd_bn(BN* a, const BN* m)
+{
+    do {
+        for (int i = 0; i < NUMWORD; i++) a->v[i] = rnd32();
+    } while (ucmp(a, m) >= 0);
+    a->s = 0;
+}
+
+// m - k (k 는 작은 수), 경계값 테스트용
+static void sub_small(BN* a, const BN* m, uint32_t k)
+{
+    BN t = {{0}, 0};
+
+    t.v[0] = k;
+    usub(a, m, &t);
+    a->s = 0;
+}
+
+// 두 점이 같은지 (무한원점끼리는 같음)
+static int eq_af(const EC_POINT_AF* a, const EC_POINT_AF* b)
+{
+    if (a->is_infty || b->is_infty) return a->is_infty == b->is_infty;
+    return !ucmp(&a->x, &b->x) && !ucmp(&a->y, &b->y);
+}
+
+// x = 0 인 P-256 의 점 (0, sqrt(b)), y 를 뒤집은 것도 곡선 위의 점
+static const EC_POINT_AF pt_x0 = {{{0}, 0},
+    {{0x174f93f4, 0x28bf856a, 0x1dae8717, 0x541c2af3, 0x84a06bb6, 0x2433bd5d, 0x0e2f83d7, 0x66485c78}, 0}, 0};
+
+// r = a b + c mod n (a, b, c < n), G 의 배수로 만든 점들의 기대값 계산용
+static void mac_n(BN* r, const BN* a, const BN* b, const BN* c)
+{
+    np256_fe x, y, z;
+
+    memcpy(x.v, a->v, sizeof(x.v));
+    memcpy(y.v, b->v, sizeof(y.v));
+    memcpy(z.v, c->v, sizeof(z.v));
+    np256_to_mont(&x, &x);
+    np256_mul(&x, &x, &y);
+    np256_add(&x, &x, &z);
+    memcpy(r->v, x.v, sizeof(x.v));
+    r->s = 0;
+}
 
 void test_add()
 {
@@ -27,9 +102,9 @@ void test_add()
         fwrite("\n\n", sizeof(char), 2, outfile);
     }
 end:
-    fclose(infile_a);
-    fclose(infile_b);
-    fclose(outfile);
+    if (infile_a) fclose(infile_a);
+    if (infile_b) fclose(infile_b);
+    if (outfile) fclose(outfile);
 }
 void test_sub()
 {
@@ -58,9 +133,9 @@ void test_sub()
         fwrite("\n\n", sizeof(char), 2, outfile);
     }
 end:
-    fclose(infile_a);
-    fclose(infile_b);
-    fclose(outfile);
+    if (infile_a) fclose(infile_a);
+    if (infile_b) fclose(infile_b);
+    if (outfile) fclose(outfile);
 }
 void test_mul_os()
 {
@@ -90,9 +165,9 @@ void test_mul_os()
         fwrite("\n\n", sizeof(char), 2, outfile);
     }
 end:
-    fclose(infile_a);
-    fclose(infile_b);
-    fclose(outfile);
+    if (infile_a) fclose(infile_a);
+    if (infile_b) fclose(infile_b);
+    if (outfile) fclose(outfile);
 }
 void test_mul_ps()
 {
@@ -122,9 +197,9 @@ void test_mul_ps()
         fwrite("\n\n", sizeof(char), 2, outfile);
     }
 end:
-    fclose(infile_a);
-    fclose(infile_b);
-    fclose(outfile);
+    if (infile_a) fclose(infile_a);
+    if (infile_b) fclose(infile_b);
+    if (outfile) fclose(outfile);
 }
 void test_sqr()
 {
@@ -154,9 +229,9 @@ void test_sqr()
         fwrite("\n\n", sizeof(char), 2, outfile);
     }
 end:
-    fclose(infile_a);
-    fclose(infile_b);
-    fclose(outfile);
+    if (infile_a) fclose(infile_a);
+    if (infile_b) fclose(infile_b);
+    if (outfile) fclose(outfile);
 }
 void test_mod()
 {
@@ -187,9 +262,9 @@ void test_mod()
         fwrite("\n\n", sizeof(char), 2, outfile);
     }
 end:
-    fclose(infile_a);
-    fclose(infile_b);
-    fclose(outfile);
+    if (infile_a) fclose(infile_a);
+    if (infile_b) fclose(infile_b);
+    if (outfile) fclose(outfile);
 }
 void test_inv_bin()
 {
@@ -208,15 +283,736 @@ void test_inv_bin()
         }
 
         // R = A^{-1} mod P
-        inv_bin(&R, &A);
+        inv(&R, &A);
 
         // write R
         for(int i = NUMWORD - 1; i >= 0; i--) fprintf(outfile, "%08X", R.v[i]);
         fwrite("\n\n", sizeof(char), 2, outfile);
     }
 end:
-    fclose(infile_a);
-    fclose(outfile);
+    if (infile_a) fclose(infile_a);
+    if (outfile) fclose(outfile);
+}
+void test_inv_fermat()
+{
+    FILE* infile_a;
+    FILE* outfile;
+    BN A, R;
+
+    infile_a = fopen("testvectors_inv_bin/TV_opA.txt", "r");
+    outfile  = fopen("testvectors_inv_bin/TV_PFINV_FERMAT_TV_res.txt", "w");
+    if(infile_a == NULL) goto end;
+
+    while (!feof(infile_a)) {
+        // read A
+        for(int i = NUMWORD - 1; i >= 0; i--) {
+            fscanf(infile_a, "%08x", &A.v[i]);
+        }
+
+        // R = A^{p-2} mod P, field engine domain 안에서 계산
+        to_fe(&A, &A);
+        inv_fermat(&R, &A);
+        from_fe(&R, &R);
+
+        // write R
+        for(int i = NUMWORD - 1; i >= 0; i--) fprintf(outfile, "%08X", R.v[i]);
+        fwrite("\n\n", sizeof(char), 2, outfile);
+    }
+end:
+    if (infile_a) fclose(infile_a);
+    if (outfile) fclose(outfile);
+}
+
+/*  field_tmpl.h 가 모듈러스에서 계산한 R mod p, R^2 mod p 가 arith_lib 의 RmodP, RRmodP 와 같은지,
+    템플릿 곱셈 fp256_mul 이 mulp 와 같은지 (벡터 파일 없이) */
+void test_field_tmpl_const()
+{
+    fp256_fe A, B, R;
+    BN a, b, e;
+    int bad = 0, cnt = 2;
+
+    if (memcmp(fp256_one.v, RmodP.v, sizeof(fp256_one.v))) bad++;
+    if (memcmp(fp256_rr.v, RRmodP.v, sizeof(fp256_rr.v))) bad++;
+
+    for (int i = 0; i < TEST_N; i++) {
+        rnd_bn(&a, &P);
+        rnd_bn(&b, &P);
+        if (i == 0) sub_small(&a, &P, 1);
+        if (i == 0) sub_small(&b, &P, 1);
+        memcpy(A.v, a.v, sizeof(A.v));
+        memcpy(B.v, b.v, sizeof(B.v));
+        fp256_to_mont(&A, &A);
+        fp256_to_mont(&B, &B);
+        fp256_mul(&R, &A, &B);
+        fp256_from_mont(&R, &R);
+        mulp(&e, &a, &b);
+        if (memcmp(R.v, e.v, sizeof(R.v))) bad++;
+        cnt++;
+    }
+
+    printf("field_tmpl: %d / %d mismatch\n", bad, cnt);
+}
+
+void test_field_tmpl()
+{
+    FILE* infile_a;
+    FILE* infile_b;
+    FILE* outfile;
+    fp256_fe A, B, R;
+
+    infile_a = fopen("testvectors_mod/TV_opA.txt", "r");
+    infile_b = fopen("testvectors_mod/TV_opB.txt", "r");
+    outfile  = fopen("testvectors_mod/TV_PFMUL_TMPL_TV_res.txt", "w");
+    if(infile_a == NULL || infile_b == NULL) goto end;
+
+    while (!feof(infile_a)) {
+        // read A and B
+        for(int i = NUMWORD - 1; i >= 0; i--) {
+            fscanf(infile_a, "%08x", &A.v[i]);
+            fscanf(infile_b, "%08x", &B.v[i]);
+        }
+
+        // R = A * B mod P, 템플릿 montgomery 곱셈
+        fp256_to_mont(&A, &A);
+        fp256_to_mont(&B, &B);
+        fp256_mul(&R, &A, &B);
+        fp256_from_mont(&R, &R);
+
+        // write R
+        for(int i = NUMWORD - 1; i >= 0; i--) fprintf(outfile, "%08X", R.v[i]);
+        fwrite("\n\n", sizeof(char), 2, outfile);
+    }
+end:
+    if (infile_a) fclose(infile_a);
+    if (infile_b) fclose(infile_b);
+    if (outfile) fclose(outfile);
+}
+
+/*  Karatsuba 곱셈/제곱 (umul_kara1/2, usqr_kara1/2) 을 umul_os 와 비교
+    피연산자는 p 로 줄이지 않은 256비트: 난수, 모두 1 (중간 합의 캐리가 가장 큼), 위쪽만 찬 값 (상위 반 / 최상위 워드), 0 */
+void test_kara()
+{
+    BN a, b;
+    BN2 e, r[4];
+    int bad = 0, cnt = 0;
+
+    for (int i = 0; i < TEST_N + 5; i++) {
+        for (int j = 0; j < NUMWORD; j++) {
+            a.v[j] = rnd32();
+            b.v[j] = rnd32();
+        }
+        if (i < 5) {
+            memset(&a, 0, sizeof(a));
+            for (int j = 0; j < NUMWORD; j++) {
+                if (i == 0) a.v[j] = 0xffffffff;                            // 모두 1
+                if (i == 1 && j >= NUMWORD / 2) a.v[j] = 0xffffffff;        // 상위 반
+                if (i == 2 && j == NUMWORD - 1) a.v[j] = 0xffffffff;        // 최상위 워드
+                if (i == 3 && j >= NUMWORD / 2) a.v[j] = rnd32() | 0x80000000;
+            }
+            if (i < 3) set_bn(&b, &a);
+        }
+        a.s = b.s = 0;
+
+        umul_os(&e, &a, &b);
+        umul_kara1(&r[0], &a, &b);
+        umul_kara2(&r[1], &a, &b);
+        for (int k = 0; k < 2; k++) {
+            if (memcmp(r[k].v, e.v, sizeof(e.v))) bad++;
+        }
+
+        umul_os(&e, &a, &a);
+        usqr_kara1(&r[2], &a);
+        usqr_kara2(&r[3], &a);
+        for (int k = 2; k < 4; k++) {
+            if (memcmp(r[k].v, e.v, sizeof(e.v))) bad++;
+        }
+        cnt += 4;
+    }
+
+    printf("kara: %d / %d mismatch\n", bad, cnt);
+}
+
+/*  fused 커널 ab + cd, ab - cd 를 montgomery / solinas 모두 mulp 두번 + addp / subp 와 비교
+    경계: 모두 p - 1 (ab + cd 가 2^512 를 넘고 pR 이상이 되는 경우), ab = 0 또는 1 이고 cd = (p - 1)^2 (뺄셈이 음수) */
+void test_mul_fused()
+{
+    BN a, b, c, d, r, e, t;
+    int bad = 0, cnt = 0;
+
+    for (int i = 0; i < TEST_N + 4; i++) {
+        rnd_bn(&a, &P);
+        rnd_bn(&b, &P);
+        rnd_bn(&c, &P);
+        rnd_bn(&d, &P);
+        if (i < 4) {
+            sub_small(&a, &P, 1);
+            sub_small(&c, &P, 1);
+            set_bn(&b, &a);
+            set_bn(&d, &c);
+            if (i == 1 || i == 3) memset(&a, 0, sizeof(a));
+            if (i == 3) a.v[0] = 1;
+            if (i == 1 || i == 3) set_bn(&b, &a);
+            if (i == 2) {
+                memset(&c, 0, sizeof(c));
+                memset(&d, 0, sizeof(d));
+            }
+        }
+
+        // montgomery
+        mulp_mont(&e, &a, &b);
+        mulp_mont(&t, &c, &d);
+        addp(&e, &e, &t);
+        mulp_add_mul_mont(&r, &a, &b, &c, &d);
+        if (ucmp(&r, &e)) bad++;
+        subp(&e, &e, &t);
+        subp(&e, &e, &t);
+        mulp_sub_mul_mont(&r, &a, &b, &c, &d);
+        if (ucmp(&r, &e)) bad++;
+
+        // solinas
+        mulp_solinas(&e, &a, &b);
+        mulp_solinas(&t, &c, &d);
+        addp(&e, &e, &t);
+        mulp_add_mul_solinas(&r, &a, &b, &c, &d);
+        if (ucmp(&r, &e)) bad++;
+        subp(&e, &e, &t);
+        subp(&e, &e, &t);
+        mulp_sub_mul_solinas(&r, &a, &b, &c, &d);
+        if (ucmp(&r, &e)) bad++;
+        cnt += 4;
+    }
+
+    printf("mulp_add/sub_mul: %d / %d mismatch\n", bad, cnt);
+}
+
+/*  inv_divstep (mod p) 를 inv (binary EEA), inv_fermat 과, inv_divstep_n (mod n) 을 np256 의 fermat 과 비교
+    signed-30 표현의 모듈러스와 역원 상수를 손으로 적었으므로 1, 2, p-1, n-1 같은 경계값도 넣는다. */
+void test_inv_divstep()
+{
+    BN A, R1, R2, R3;
+    np256_fe a, r;
+    int bad = 0, bad_n = 0, cnt = 0;
+
+    for (int i = 0; i < TEST_N + 4; i++) {
+        // mod p
+        if (i < 4) {
+            memset(&A, 0, sizeof(A));
+            if (i < 2) A.v[0] = i + 1;
+            else sub_small(&A, &P, i - 1);
+        } else {
+            rnd_bn(&A, &P);
+        }
+
+        inv_divstep(&R1, &A);
+        inv(&R2, &A);
+        to_fe(&R3, &A);
+        inv_fermat(&R3, &R3);
+        from_fe(&R3, &R3);
+        if (ucmp(&R1, &R2) || ucmp(&R1, &R3)) bad++;
+
+        // mod n
+        if (i < 4) {
+            memset(&A, 0, sizeof(A));
+            if (i < 2) A.v[0] = i + 1;
+            else sub_small(&A, &N, i - 1);
+        } else {
+            rnd_bn(&A, &N);
+        }
+
+        inv_divstep_n(&R1, &A);
+        memcpy(a.v, A.v, sizeof(a.v));
+        np256_to_mont(&a, &a);
+        np256_inv(&r, &a);
+        np256_from_mont(&r, &r);
+        if (memcmp(R1.v, r.v, sizeof(r.v))) bad_n++;
+        cnt++;
+    }
+
+    printf("inv_divstep   (mod p): %d / %d mismatch\n", bad, cnt);
+    printf("inv_divstep_n (mod n): %d / %d mismatch\n", bad_n, cnt);
+}
+
+/*  inv_batch 를 원소마다 invp 와 비교 (n = 1, 2, 3, 64, 원소는 field engine domain)
+    첫 묶음에는 1 과 p - 1 을 넣는다. */
+void test_inv_batch()
+{
+    static const size_t num[] = {1, 2, 3, 64};
+    BN a[64], fe[64], r[64], e;
+    int bad = 0, cnt = 0;
+
+    for (int t = 0; t < 4; t++) {
+        for (size_t i = 0; i < num[t]; i++) {
+            do {
+                rnd_bn(&a[i], &P);
+            } while (!ucmp(&a[i], &zero));
+            if (t == 3 && i == 0) set_bn(&a[i], &one);
+            if (t == 3 && i == 1) sub_small(&a[i], &P, 1);
+            to_fe(&fe[i], &a[i]);
+        }
+
+        inv_batch(r, fe, num[t]);
+        for (size_t i = 0; i < num[t]; i++) {
+            from_fe(&r[i], &r[i]);
+            invp(&e, &a[i]);
+            if (ucmp(&r[i], &e)) bad++;
+            cnt++;
+        }
+    }
+
+    printf("inv_batch: %d / %d mismatch\n", bad, cnt);
+}
+
+/*  multi-buffer (arith_x8) 를 backend 마다 (일반 C, AVX2, AVX-512 IFMA) 한 lane 씩 addp / subp / mulp / sqrp 와 비교
+    x8 값은 [0, 2p) 로 느슨하게 유지되므로 unpack 하지 않고 연산을 이어가서 그 범위도 확인한다.
+        r = ((a b + a) - b)^2 를 ROUNDS 번 반복 (a, b 는 lane 마다 다른 난수)
+    이 CPU/빌드에서 쓸 수 없는 backend 는 건너뛴다. */
+void test_x8()
+{
+    static const char* name[3] = {"C", "AVX2", "IFMA"};
+    const int rounds = 8;
+    BN a[X8_LANES], b[X8_LANES], r[X8_LANES], out[X8_LANES];
+    BN_X8 xa, xb, xr;
+    int bad = 0, cnt = 0, keep = x8_backend();
+
+    for (int backend = X8_BACKEND_C; backend <= X8_BACKEND_IFMA; backend++) {
+        if (x8_set_backend(backend) < 0) {
+            printf("x8 %-4s: not supported, skipped\n", name[backend]);
+            continue;
+        }
+
+        bad = cnt = 0;
+        for (int t = 0; t < TEST_N / X8_LANES; t++) {
+            for (int l = 0; l < X8_LANES; l++) {
+                rnd_bn(&a[l], &P);
+                rnd_bn(&b[l], &P);
+                set_bn(&r[l], &a[l]);
+            }
+            // 경계값: 0, 1, p - 1
+            if (t == 0) {
+                memset(&a[0], 0, sizeof(BN));
+                memset(&a[1], 0, sizeof(BN));
+                a[1].v[0] = 1;
+                sub_small(&a[2], &P, 1);
+                sub_small(&b[3], &P, 1);
+                for (int l = 0; l < 3; l++) set_bn(&r[l], &a[l]);
+            }
+
+            pack_x8(&xa, a);
+            pack_x8(&xb, b);
+            pack_x8(&xr, r);
+            for (int k = 0; k < rounds; k++) {
+                mulp_x8(&xr, &xr, &xb);
+                addp_x8(&xr, &xr, &xa);
+                subp_x8(&xr, &xr, &xb);
+                sqrp_x8(&xr, &xr);
+                for (int l = 0; l < X8_LANES; l++) {
+                    mulp(&r[l], &r[l], &b[l]);
+                    addp(&r[l], &r[l], &a[l]);
+                    subp(&r[l], &r[l], &b[l]);
+                    sqrp(&r[l], &r[l]);
+                }
+            }
+            unpack_x8(out, &xr);
+
+            for (int l = 0; l < X8_LANES; l++) {
+                if (ucmp(&out[l], &r[l])) bad++;
+                cnt++;
+            }
+        }
+        printf("x8 %-4s: %d / %d mismatch\n", name[backend], bad, cnt);
+    }
+
+    x8_set_backend(keep);
+}
+
+/*  ec_tmpl.h 로 만든 곡선 (P-384, secp256k1) 의 손으로 적은 상수 (p, b, G, n) 확인
+    G 가 곡선 위에 있는지, n G 가 무한원점인지, 고정된 k 에 대한 k G 가 python 으로 계산한 값과 같은지 본다. */
+void test_curve_kat()
+{
+    static const uint32_t k384[12] = {0x12345678, 0x0ff00ff0, 0x33cc33cc, 0x55aa55aa, 0xc3d2e1f0, 0x8796a5b4,
+                                      0x4b5a6978, 0x0f1e2d3c, 0x76543210, 0xfedcba98, 0x89abcdef, 0x01234567};
+    static const fp384_fe x384 = {{0xce3d23a7, 0xf4fc6512, 0x64f86602, 0xfed959aa, 0xbf97277e, 0xa75d3aa2,
+                                   0xb458af18, 0xb28f0468, 0x17180ce7, 0x94c70391, 0x2bd6f90b, 0x45a50173}};
+    static const fp384_fe y384 = {{0x42ced210, 0x8c151895, 0x5f0fa3bc, 0x8b906284, 0x797a2476, 0x2e28afa9,
+                                   0xdacb122a, 0x24ca0170, 0xcfdfe5d3, 0x36c2921e, 0x62d5071b, 0x84bb4e81}};
+    static const uint32_t k256[8] = {0x4b5a6978, 0x0f1e2d3c, 0x76543210, 0xfedcba98,
+                                     0x89abcdef, 0x01234567, 0xcafebabe, 0xdeadbeef};
+    static const fk256_fe xk = {{0x5ce3ce0f, 0xcba7dc1e, 0x138d5a78, 0x01c5e7e3,
+                                 0xcf0c8149, 0x18dd0191, 0x4cf56f92, 0xc6495bf1}};
+    static const fk256_fe yk = {{0xe7b1f153, 0xa54fcc6d, 0xc6ec9243, 0x5eb43c67,
+                                 0xd69c5c11, 0x6d3284c8, 0xedecabef, 0x7bb665e0}};
+    p384_af r384;
+    k256_af rk;
+    int bad = 0;
+
+    // P-384
+    if (!p384_on_curve(&p384_g)) bad++;
+    p384_ecsm_ltr(&r384, &p384_g, p384_n);
+    if (!r384.is_infty) bad++;
+    p384_ecsm_ltr(&r384, &p384_g, k384);
+    if (r384.is_infty || !fp384_eq(&r384.x, &x384) || !fp384_eq(&r384.y, &y384)) bad++;
+
+    // secp256k1
+    if (!k256_on_curve(&k256_g)) bad++;
+    k256_ecsm_ltr(&rk, &k256_g, k256_n);
+    if (!rk.is_infty) bad++;
+    k256_ecsm_ltr(&rk, &k256_g, k256);
+    if (rk.is_infty || !fk256_eq(&rk.x, &xk) || !fk256_eq(&rk.y, &yk)) bad++;
+
+    printf("curve kat (p384, k256): %d / 6 mismatch\n", bad);
+}
+
+// secp256k1 의 두 점이 같은지 (무한원점끼리는 같음)
+static int k256_eq_af(const k256_af* a, const k256_af* b)
+{
+    if (a->is_infty || b->is_infty) return a->is_infty == b->is_infty;
+    return fk256_eq(&a->x, &b->x) && fk256_eq(&a->y, &b->y);
+}
+
+/*  k256_ecsm_glv (임의의 점), k256_ecsm_glv_base (G) 를 k256_ecsm_ltr 과 비교
+    손으로 적은 beta, lambda, -b1, -b2, g1, g2 가 틀리면 분해 k = k1 + k2 lambda 나 lambda P = (beta x, y) 가 어긋난다.
+    기준점: G, 임의의 점 3개 / 스칼라: 0, 1, n - 1, n, 2^256 - 1, lambda, 난수 (256비트, n 이상일 수 있음) */
+void test_k256_glv()
+{
+    k256_af base[4], A, R;
+    uint32_t k[8];
+    int bad = 0, cnt = 0;
+
+    base[0] = k256_g;
+    for (int b = 1; b < 4; b++) {
+        for (int i = 0; i < 8; i++) k[i] = rnd32();
+        k256_ecsm_ltr(&base[b], &k256_g, k);
+    }
+
+    for (int b = 0; b < 4; b++) {
+        for (int i = 0; i < TEST_N / 4 + 6; i++) {
+            memset(k, 0, sizeof(k));
+            if (i < 2) {
+                k[0] = i;
+            } else if (i < 4) {
+                memcpy(k, k256_n, sizeof(k));
+                if (i == 2) k[0]--;
+            } else if (i == 4) {
+                memset(k, 0xff, sizeof(k));
+            } else if (i == 5) {
+                memcpy(k, k256_lambda.v, sizeof(k));
+            } else {
+                for (int j = 0; j < 8; j++) k[j] = rnd32();
+            }
+
+            k256_ecsm_ltr(&A, &base[b], k);
+            k256_ecsm_glv(&R, &base[b], k);
+            if (!k256_eq_af(&A, &R)) bad++;
+            cnt++;
+            if (b == 0) {
+                k256_ecsm_glv_base(&R, k);
+                if (!k256_eq_af(&A, &R)) bad++;
+                cnt++;
+            }
+        }
+    }
+
+    printf("k256_ecsm_glv: %d / %d mismatch\n", bad, cnt);
+}
+
+/*  ecsm_complete (RCB complete 공식) 를 ecsm_ltr 과 비교
+    기준점: G, 임의의 점, 무한원점
+    스칼라: 0, 1, n - 2, n - 1, n (무한원점), n + 2 (마지막 덧셈이 P == Q), 난수
+    예외 처리가 없는 공식이므로 무한원점, P == Q, P == -Q 를 거치는 스칼라를 넣는다. */
+void test_ecsm_complete()
+{
+    EC_POINT_AF base[3], A, C;
+    BN k, two = {{2}, 0};
+    int bad = 0, cnt = 0;
+
+    set_ec_point_af(&base[0], &fix_g_ltr[1]);
+    rnd_bn(&k, &N);
+    ecsm_ltr(&base[1], &base[0], &k);
+    memset(&base[2], 0, sizeof(base[2]));
+    base[2].is_infty = 1;
+
+    for (int b = 0; b < 3; b++) {
+        for (int i = 0; i < TEST_N / 4 + 6; i++) {
+            if (i < 2) {
+                memset(&k, 0, sizeof(k));
+                k.v[0] = i;
+            } else if (i < 5) {
+                sub_small(&k, &N, 4 - i);
+            } else if (i == 5) {
+                uadd(&k, &N, &two);
+            } else {
+                rnd_bn(&k, &N);
+            }
+
+            ecsm_complete(&C, &base[b], &k);
+            ecsm_ltr(&A, &base[b], &k);
+            if (!eq_af(&A, &C)) bad++;
+            cnt++;
+        }
+    }
+
+    printf("ecsm_complete: %d / %d mismatch\n", bad, cnt);
+}
+
+/*  ecsm_ladder 를 ecsm_ltr 과 비교
+    기준점: G, 임의의 점, x = 0 인 점 (0, +-sqrt(b)) --- 마지막 Z 복원이 x_P 로 나누는 경우
+    스칼라: 0, 1, 2, 3, n (무한원점), n - 1, n - 2, 난수
+    k = 0, n 은 -DECC_INV_EEA 빌드에서 inv 에 0 이 들어가면 끝나지 않으므로 그 빌드로도 돌린다. */
+void test_ecsm_ladder()
+{
+    EC_POINT_AF base[4], A, L;
+    BN k;
+    int bad = 0, cnt = 0;
+
+    set_ec_point_af(&base[0], &fix_g_ltr[1]);
+    rnd_bn(&k, &N);
+    ecsm_ltr(&base[1], &base[0], &k);
+    set_ec_point_af(&base[2], &pt_x0);
+    set_ec_point_af(&base[3], &pt_x0);
+    subp(&base[3].y, &zero, &pt_x0.y);
+
+    for (int b = 0; b < 4; b++) {
+        for (int i = 0; i < TEST_N / 4 + 7; i++) {
+            if (i < 4) {
+                memset(&k, 0, sizeof(k));
+                k.v[0] = i;
+            } else if (i < 7) {
+                sub_small(&k, &N, i - 4);
+            } else {
+                rnd_bn(&k, &N);
+            }
+
+            ecsm_ladder(&L, &base[b], &k);
+            if (!ucmp(&k, &N)) {
+                if (!L.is_infty) bad++;
+            } else {
+                ecsm_ltr(&A, &base[b], &k);
+                if (!eq_af(&A, &L)) bad++;
+            }
+            cnt++;
+        }
+    }
+
+    printf("ecsm_ladder: %d / %d mismatch\n", bad, cnt);
+}
+
+/*  ecsm_wnaf 를 w = 2 .. ECC_WNAF_WMAX 마다 ecsm_ltr 과 비교
+    기준점: G, 임의의 점, x = 0 인 점, 무한원점
+    스칼라: 0, 1, 2, 3, n - 1, n - 2, 2^256 - 1 (NAF 가 257 자리), 난수 */
+void test_ecsm_wnaf()
+{
+    EC_POINT_AF base[4], A, W;
+    BN k;
+    int bad = 0, cnt = 0;
+
+    set_ec_point_af(&base[0], &fix_g_ltr[1]);
+    rnd_bn(&k, &N);
+    ecsm_ltr(&base[1], &base[0], &k);
+    set_ec_point_af(&base[2], &pt_x0);
+    memset(&base[3], 0, sizeof(base[3]));
+    base[3].is_infty = 1;
+
+    for (int w = 2; w <= ECC_WNAF_WMAX; w++) {
+        for (int b = 0; b < 4; b++) {
+            for (int i = 0; i < TEST_N / 16 + 7; i++) {
+                if (i < 4) {
+                    memset(&k, 0, sizeof(k));
+                    k.v[0] = i;
+                } else if (i < 6) {
+                    sub_small(&k, &N, i - 3);
+                } else if (i == 6) {
+                    memset(&k, 0xff, sizeof(k));
+                    k.s = 0;
+                } else {
+                    rnd_bn(&k, &N);
+                }
+
+                ecsm_wnaf(&W, &base[b], &k, w);
+                ecsm_ltr(&A, &base[b], &k);
+                if (!eq_af(&A, &W)) bad++;
+                cnt++;
+            }
+        }
+    }
+
+    printf("ecsm_wnaf: %d / %d mismatch\n", bad, cnt);
+}
+
+/*  ecsm_comb 를 G 에서 ecsm_ltr 과 비교
+    스칼라: 0, 1, n - 1, n - 2, 2^256 - 1, 한 비트만 켠 수 (각 열/블록의 처음과 끝, 마지막 행), 난수 */
+void test_ecsm_comb()
+{
+    static const int pos[] = {0, ECC_COMB_SPAN - 1, ECC_COMB_SPAN, ECC_COMB_COLS - 1, ECC_COMB_COLS,
+                              BITS256 - ECC_COMB_COLS, BITS256 - 1};
+    const int npos = (int)(sizeof(pos) / sizeof(pos[0]));
+    EC_POINT_AF A, C;
+    BN k;
+    int bad = 0, cnt = 0;
+
+    for (int i = 0; i < TEST_N + npos + 5; i++) {
+        memset(&k, 0, sizeof(k));
+        if (i < 2) {
+            k.v[0] = i;
+        } else if (i < 4) {
+            sub_small(&k, &N, i - 1);
+        } else if (i == 4) {
+            memset(&k, 0xff, sizeof(k));
+            k.s = 0;
+        } else if (i < npos + 5) {
+            k.v[pos[i - 5] / WORDBITS] = 1u << (pos[i - 5] % WORDBITS);
+        } else {
+            rnd_bn(&k, &N);
+        }
+
+        ecsm_comb(&C, &fix_g_ltr[1], &k);
+        ecsm_ltr(&A, &fix_g_ltr[1], &k);
+        if (!eq_af(&A, &C)) bad++;
+        cnt++;
+    }
+
+    printf("ecsm_comb: %d / %d mismatch\n", bad, cnt);
+}
+
+/*  ecsm_ct 를 G 에서 ecsm_ltr 과 비교
+    스칼라: 0, 1, 2 (짝수는 k + n 을 쓰는 경로), n - 1, n - 2, 2^256 - 1, 2^256 - 2 (k + n 이 257비트), 난수
+    k = 0 (k + n = n) 은 마지막 덧셈에서 ecadd_jc 의 예외 처리 (acc = -T) 를 타서 무한원점이 된다. */
+void test_ecsm_ct()
+{
+    EC_POINT_AF A, C;
+    BN k;
+    int bad = 0, cnt = 0;
+
+    for (int i = 0; i < TEST_N + 7; i++) {
+        memset(&k, 0, sizeof(k));
+        if (i < 3) {
+            k.v[0] = i;
+        } else if (i < 5) {
+            sub_small(&k, &N, i - 2);
+        } else if (i < 7) {
+            memset(&k, 0xff, sizeof(k));
+            k.v[0] -= i - 5;
+            k.s = 0;
+        } else {
+            rnd_bn(&k, &N);
+        }
+
+        ecsm_ct(&C, &fix_g_ltr[1], &k);
+        ecsm_ltr(&A, &fix_g_ltr[1], &k);
+        if (!eq_af(&A, &C)) bad++;
+        cnt++;
+    }
+
+    printf("ecsm_ct: %d / %d mismatch\n", bad, cnt);
+}
+
+/*  ecsm_double (u1 G + u2 Q) 를 ecsm_ltr 과 비교, Q = q G 로 만들어서 기대값은 (u1 + u2 q) G
+    경계: u1 = 0, u2 = 0, 둘 다 0, Q = G, Q = -G, u1 G = -u2 Q (무한원점), Q 가 무한원점,
+          Q = G 이고 u1 = u2 (두 표의 점이 같아지는 덧셈), u1 = u2 = n - 1 */
+void test_ecsm_double()
+{
+    EC_POINT_AF A, D, Q;
+    BN u1, u2, q, s;
+    int bad = 0, cnt = 0;
+
+    for (int i = 0; i < TEST_N + 9; i++) {
+        rnd_bn(&u1, &N);
+        rnd_bn(&u2, &N);
+        rnd_bn(&q, &N);
+        if (i == 0 || i == 2) memset(&u1, 0, sizeof(u1));
+        if (i == 1 || i == 2) memset(&u2, 0, sizeof(u2));
+        if (i == 3 || i == 7) set_bn(&q, &one);
+        if (i == 4) sub_small(&q, &N, 1);
+        if (i == 5) {
+            mac_n(&s, &u2, &q, &zero);
+            usub(&u1, &N, &s);
+        }
+        if (i == 6) memset(&q, 0, sizeof(q));
+        if (i == 7) set_bn(&u1, &u2);
+        if (i == 8) {
+            sub_small(&u1, &N, 1);
+            sub_small(&u2, &N, 1);
+        }
+
+        if (ucmp(&q, &zero)) {
+            ecsm_ltr(&Q, &fix_g_ltr[1], &q);
+        } else {
+            memset(&Q, 0, sizeof(Q));
+            Q.is_infty = 1;
+        }
+
+        mac_n(&s, &u2, &q, &u1);
+        ecsm_double(&D, &u1, &Q, &u2);
+        ecsm_ltr(&A, &fix_g_ltr[1], &s);
+        if (!eq_af(&A, &D) || (i == 5 && !D.is_infty)) bad++;
+        cnt++;
+    }
+
+    printf("ecsm_double: %d / %d mismatch\n", bad, cnt);
+}
+
+/*  ecsm_multi 를 ecsm_ltr 과 비교, points[i] = q_i G 로 만들어서 기대값은 (sum s_i q_i) G
+    n = 0, 1 과 window 크기 c 가 달라지는 n 에서, 점 사이에 다음을 섞는다.
+        같은 점 (같은 bucket 에서 doubling), 앞 점의 -P 와 같은 스칼라 (bucket 이 무한원점), 무한원점, 스칼라 0
+    n = 1 은 스칼라 0, 1, n - 1 과 무한원점도 본다. 모든 점과 스칼라가 같은 경우도 넣는다. */
+#define TEST_MSM_MAX 300
+
+void test_ecsm_multi()
+{
+    static const size_t num[] = {1, 2, 5, 16, 40, TEST_MSM_MAX};
+    static EC_POINT_AF pts[TEST_MSM_MAX];
+    static BN sc[TEST_MSM_MAX], q[TEST_MSM_MAX];
+    EC_POINT_AF A, M;
+    BN s;
+    int bad = 0, cnt = 0;
+
+    // n = 0
+    if (ecsm_multi(&M, sc, pts, 0) || !M.is_infty) bad++;
+    cnt++;
+
+    for (int t = 0; t < (int)(sizeof(num) / sizeof(num[0])); t++) {
+        for (int r = 0; r < 6; r++) {
+            size_t n = num[t];
+
+            for (size_t i = 0; i < n; i++) {
+                rnd_bn(&sc[i], &N);
+                rnd_bn(&q[i], &N);
+                if (r == 1 && i > 0) {
+                    set_bn(&sc[i], &sc[0]);
+                    set_bn(&q[i], &q[0]);
+                } else if (r > 1 && i > 0) {
+                    switch (i % 5) {
+                    case 1: set_bn(&q[i], &q[i - 1]); break;
+                    case 2: usub(&q[i], &N, &q[i - 1]); set_bn(&sc[i], &sc[i - 1]); break;
+                    case 3: memset(&q[i], 0, sizeof(BN)); break;
+                    case 4: memset(&sc[i], 0, sizeof(BN)); break;
+                    }
+                }
+            }
+            // n = 1 의 경계
+            if (n == 1 && r == 2) memset(&sc[0], 0, sizeof(BN));
+            if (n == 1 && r == 3) set_bn(&sc[0], &one);
+            if (n == 1 && r == 4) sub_small(&sc[0], &N, 1);
+            if (n == 1 && r == 5) memset(&q[0], 0, sizeof(BN));
+
+            memset(&s, 0, sizeof(s));
+            for (size_t i = 0; i < n; i++) {
+                if (ucmp(&q[i], &zero)) {
+                    ecsm_ltr(&pts[i], &fix_g_ltr[1], &q[i]);
+                } else {
+                    memset(&pts[i], 0, sizeof(pts[i]));
+                    pts[i].is_infty = 1;
+                }
+                mac_n(&s, &sc[i], &q[i], &s);
+            }
+
+            if (ecsm_multi(&M, sc, pts, n)) bad++;
+            ecsm_ltr(&A, &fix_g_ltr[1], &s);
+            if (!eq_af(&A, &M)) bad++;
+            cnt++;
+        }
+    }
+
+    printf("ecsm_multi: %d / %d mismatch\n", bad, cnt);
 }
 
 int main(void) {
@@ -227,6 +1023,23 @@ int main(void) {
     //test_sqr();
     //test_mod();
     //test_inv_bin();
+    //test_inv_fermat();
+    //test_field_tmpl();
+    test_field_tmpl_const();
+    test_kara();
+    test_mul_fused();
+    test_inv_divstep();
+    test_inv_batch();
+    test_x8();
+    test_curve_kat();
+    test_k256_glv();
+    test_ecsm_complete();
+    test_ecsm_ladder();
+    test_ecsm_wnaf();
+    test_ecsm_comb();
+    test_ecsm_ct();
+    test_ecsm_double();
+    test_ecsm_multi();
 
     return 0;
 }
\ No newline at end of file